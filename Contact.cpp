@@ -1,23 +1,44 @@
 #include "Contact.h"
 #include "validation.h"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+#include <utility>
+
+namespace {
+    std::string toLower(std::string value) {
+        std::transform(value.begin(), value.end(), value.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        return value;
+    }
+
+    void assignTrimmed(std::string& target, std::string&& value) {
+        const std::string_view trimmed = validation::trimView(value);
+        if (trimmed.size() == value.size()) {
+            target = std::move(value);
+        } else {
+            target.assign(trimmed);
+        }
+    }
+}
 
 int Contact::getId() const {
     return id;
 }
 
-std::string Contact::getSurname() const {
+const std::string& Contact::getSurname() const {
     return surname;
 }
 
-std::string Contact::getForename() const {
+const std::string& Contact::getForename() const {
     return forename;
 }
 
-std::string Contact::getPatronymic() const {
+const std::string& Contact::getPatronymic() const {
     return patronymic;
 }
 
-std::string Contact::getAddress() const {
+const std::string& Contact::getAddress() const {
     return address;
 }
 
@@ -25,44 +46,60 @@ Date Contact::getBirthDate() const {
     return birthDate;
 }
 
-std::string Contact::getEmail() const {
+const std::string& Contact::getEmail() const {
     return email;
 }
 
-std::vector<PhoneNumber> Contact::getPhoneNumbers() const {
+const std::vector<PhoneNumber>& Contact::getPhoneNumbers() const {
     return phoneNumbers;
 }
 
+const ContactSearchKeys& Contact::getSearchKeys() const {
+    return searchKeys;
+}
+
 void Contact::setId(const int _id) {
     id = _id;
+    searchKeys.id = std::to_string(id);
 }
 
-void Contact::setSurname(const std::string& _surname) {
-    surname = validation::trim(_surname);
+void Contact::setSurname(std::string _surname) {
+    assignTrimmed(surname, std::move(_surname));
+    searchKeys.surname = toLower(surname);
 }
 
-void Contact::setForename(const std::string& _forename) {
-    forename = validation::trim(_forename);
+void Contact::setForename(std::string _forename) {
+    assignTrimmed(forename, std::move(_forename));
+    searchKeys.forename = toLower(forename);
 }
 
-void Contact::setPatronymic(const std::string& _patronymic) {
-    patronymic = validation::trim(_patronymic);
+void Contact::setPatronymic(std::string _patronymic) {
+    assignTrimmed(patronymic, std::move(_patronymic));
+    searchKeys.patronymic = toLower(patronymic);
 }
 
-void Contact::setAddress(const std::string& _address) {
-    address = validation::trim(_address);
+void Contact::setAddress(std::string _address) {
+    assignTrimmed(address, std::move(_address));
+    searchKeys.address = toLower(address);
 }
 
 void Contact::setBirthDate(const Date& _birthDate) {
     birthDate = _birthDate;
+    searchKeys.birthDate = std::to_string(birthDate.day) + "." + std::to_string(birthDate.month) +
+        "." + std::to_string(birthDate.year);
 }
 
-void Contact::setEmail(const std::string& _email) {
-    email = validation::normalizeEmail(_email);
+void Contact::setEmail(std::string _email) {
+    validation::normalizeEmailInPlace(_email);
+    email = std::move(_email);
+    searchKeys.email = email;
 }
 
-void Contact::addPhoneNumber(const std::string& type, const std::string& number) {
-    phoneNumbers.emplace_back(validation::trim(type), validation::normalizePhoneNumber(number));
+void Contact::addPhoneNumber(std::string type, const std::string& number) {
+    std::string trimmedType;
+    assignTrimmed(trimmedType, std::move(type));
+    phoneNumbers.emplace_back(std::move(trimmedType), validation::normalizePhoneNumber(number));
+    updatePhoneSearchKey();
 }
 
 bool Contact::deletePhoneNumber(const size_t idx) {
@@ -71,6 +108,7 @@ bool Contact::deletePhoneNumber(const size_t idx) {
     }
     if (idx < phoneNumbers.size()) {
         phoneNumbers.erase(phoneNumbers.begin() + idx);
+        updatePhoneSearchKey();
         return true;
     }
     return false;
@@ -80,6 +118,7 @@ bool Contact::editPhoneNumber(const size_t idx, const std::string& newType, cons
     if (idx < phoneNumbers.size()) {
         phoneNumbers[idx].type = validation::trim(newType);
         phoneNumbers[idx].number = validation::normalizePhoneNumber(newNumber);
+        updatePhoneSearchKey();
         return true;
     }
     return false;
@@ -87,4 +126,16 @@ bool Contact::editPhoneNumber(const size_t idx, const std::string& newType, cons
 
 void Contact::clearPhoneNumbers() {
     phoneNumbers.clear();
+    searchKeys.phoneDigits.clear();
+}
+
+void Contact::updatePhoneSearchKey() {
+    searchKeys.phoneDigits.clear();
+    for (const PhoneNumber& phone : phoneNumbers) {
+        if (!searchKeys.phoneDigits.empty()) {
+            searchKeys.phoneDigits += '|';
+        }
+        std::copy_if(phone.number.begin(), phone.number.end(), std::back_inserter(searchKeys.phoneDigits),
+                     [](char c){ return std::isdigit(c); });
+    }
 }
@@ -11,6 +11,17 @@ struct PhoneNumber {
     PhoneNumber(std::string type, std::string number) : type(std::move(type)), number(std::move(number)) {}
 };
 
+struct ContactSearchKeys {
+    std::string id = "0";
+    std::string surname;
+    std::string forename;
+    std::string patronymic;
+    std::string address;
+    std::string birthDate = "0.0.0";
+    std::string email;
+    std::string phoneDigits;
+};
+
 class Contact {
     int id = 0;
     std::string surname;
@@ -20,29 +31,32 @@ class Contact {
     Date birthDate;
     std::string email;
     std::vector<PhoneNumber> phoneNumbers;
+    ContactSearchKeys searchKeys;
+
+    void updatePhoneSearchKey();
 
 public:
     Contact() = default;
-    ~Contact() = default;
 
     int getId() const;
-    std::string getSurname() const;
-    std::string getForename() const;
-    std::string getPatronymic() const;
-    std::string getAddress() const;
+    const std::string& getSurname() const;
+    const std::string& getForename() const;
+    const std::string& getPatronymic() const;
+    const std::string& getAddress() const;
     Date getBirthDate() const;
-    std::string getEmail() const;
-    std::vector<PhoneNumber> getPhoneNumbers() const;
+    const std::string& getEmail() const;
+    const std::vector<PhoneNumber>& getPhoneNumbers() const;
+    const ContactSearchKeys& getSearchKeys() const;
 
     void setId(int _id);
-    void setSurname(const std::string& _surname);
-    void setForename(const std::string& _forename);
-    void setPatronymic(const std::string& _patronymic);
-    void setAddress(const std::string& _address);
+    void setSurname(std::string _surname);
+    void setForename(std::string _forename);
+    void setPatronymic(std::string _patronymic);
+    void setAddress(std::string _address);
     void setBirthDate(const Date& _birthDate);
-    void setEmail(const std::string& _email);
+    void setEmail(std::string _email);
 
-    void addPhoneNumber(const std::string& type, const std::string& number);
+    void addPhoneNumber(std::string type, const std::string& number);
     bool deletePhoneNumber(size_t idx);
     bool editPhoneNumber(size_t idx, const std::string& newType, const std::string& newNumber);
 
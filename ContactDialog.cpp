@@ -5,8 +5,8 @@
 #include <QHeaderView>
 #include <QMessageBox>
 
-ContactDialog::ContactDialog(Phonebook& phonebook, Contact* contactToEdit, QWidget* parent)
-    : QDialog(parent), phonebook(phonebook), contactToEdit(contactToEdit) {
+ContactDialog::ContactDialog(Phonebook& phonebook, ContactPager* pager, const Contact* contactToEdit, QWidget* parent)
+    : QDialog(parent), phonebook(phonebook), pager(pager), contactToEdit(contactToEdit) {
     isEditMode = contactToEdit != nullptr;
     setupUi();
 
@@ -182,7 +182,11 @@ void ContactDialog::onSaveClicked() {
 
     const int ignoreId = isEditMode ? contactToEdit->getId() : 0;
 
-    if (!phonebook.isEmailUnique(email, ignoreId)) {
+    bool unique = true;
+    if (!isEmailUnique(email, ignoreId, unique)) {
+        return;
+    }
+    if (!unique) {
         QMessageBox::warning(this, "Error", "Email already in use.");
         editEmail->setFocus();
         return;
@@ -213,7 +217,10 @@ void ContactDialog::onSaveClicked() {
         }
 
         std::string normalizedNumber = validation::normalizePhoneNumber(number);
-        if (!phonebook.isPhoneNumberUnique(number, ignoreId)) {
+        if (!isPhoneNumberUnique(number, ignoreId, unique)) {
+            return;
+        }
+        if (!unique) {
             QMessageBox::warning(this, "Error", "Phone number in row " + QString::number(i+1) + " is already in use by other contact.");
             tablePhones->setCurrentCell(i, 1);
             return;
@@ -232,6 +239,30 @@ void ContactDialog::onSaveClicked() {
     accept();
 }
 
+bool ContactDialog::isEmailUnique(const std::string& email, const int ignoreId, bool& unique) {
+    if (pager == nullptr) {
+        unique = phonebook.isEmailUnique(email, ignoreId);
+        return true;
+    }
+    if (!pager->isEmailUnique(email, ignoreId, unique)) {
+        QMessageBox::critical(this, "Storage error", QString::fromStdString(pager->getLastError()));
+        return false;
+    }
+    return true;
+}
+
+bool ContactDialog::isPhoneNumberUnique(const std::string& number, const int ignoreId, bool& unique) {
+    if (pager == nullptr) {
+        unique = phonebook.isPhoneNumberUnique(number, ignoreId);
+        return true;
+    }
+    if (!pager->isPhoneNumberUnique(number, ignoreId, unique)) {
+        QMessageBox::critical(this, "Storage error", QString::fromStdString(pager->getLastError()));
+        return false;
+    }
+    return true;
+}
+
 Contact ContactDialog::getContact() const {
     Contact contact;
     contact.setSurname(editSurname->text().toStdString());
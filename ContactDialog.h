@@ -1,5 +1,6 @@
 #pragma once
 #include "Contact.h"
+#include "ContactPager.h"
 #include "Phonebook.h"
 #include <QDialog>
 #include <QLineEdit>
@@ -14,7 +15,8 @@ class ContactDialog : public QDialog {
     Q_OBJECT
 
 public:
-    explicit ContactDialog(Phonebook& phonebook, Contact* contactToEdit = nullptr, QWidget* parent = nullptr);
+    explicit ContactDialog(Phonebook& phonebook, ContactPager* pager = nullptr, const Contact* contactToEdit = nullptr,
+                           QWidget* parent = nullptr);
 
     Contact getContact() const;
 
@@ -25,7 +27,8 @@ private slots:
 
 private:
     Phonebook& phonebook;
-    Contact* contactToEdit;
+    ContactPager* pager;
+    const Contact* contactToEdit;
     bool isEditMode;
 
     QLineEdit* editSurname;
@@ -46,5 +49,7 @@ private:
     QPushButton* btnCancel;
 
     void loadContactData() const;
+    bool isEmailUnique(const std::string& email, int ignoreId, bool& unique);
+    bool isPhoneNumberUnique(const std::string& number, int ignoreId, bool& unique);
     void setupUi();
 };
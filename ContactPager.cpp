@@ -0,0 +1,149 @@
+#include "ContactPager.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    constexpr int SEARCH_RESULT_LIMIT = 1000;
+    constexpr int TYPE_AHEAD_LIMIT = 100;
+}
+
+ContactPager::ContactPager(PagedContactSource& source, Phonebook& phonebook, const int pageSize)
+    : source(source), phonebook(phonebook), pageSize(std::max(1, pageSize)) {}
+
+bool ContactPager::start() {
+    phonebook.clear();
+    lastId = 0;
+    exhausted = false;
+
+    int maxId = 0;
+    if (!source.fetchMaxId(maxId)) {
+        return false;
+    }
+
+    phonebook.initializeNextId(maxId);
+    phonebook.markSaved();
+    exhausted = maxId == 0;
+    return true;
+}
+
+bool ContactPager::fetchNextPage(std::vector<Contact>& page) {
+    page.clear();
+    if (exhausted) {
+        return true;
+    }
+
+    if (!source.fetchPage(lastId, pageSize, page)) {
+        return false;
+    }
+
+    if (static_cast<int>(page.size()) < pageSize) {
+        exhausted = true;
+    }
+    if (!page.empty()) {
+        lastId = page.back().getId();
+    }
+
+    page.erase(std::remove_if(page.begin(), page.end(),
+                              [this](const Contact& contact) { return isKnownLocally(contact.getId()); }),
+               page.end());
+
+    for (const Contact& contact : page) {
+        phonebook.addContactFromStorage(contact);
+    }
+    return true;
+}
+
+bool ContactPager::search(const std::map<SearchField, std::string>& criteria, std::vector<Contact>& results) {
+    results = phonebook.searchContacts(criteria);
+    if (exhausted) {
+        return true;
+    }
+
+    std::vector<Contact> stored;
+    if (!source.searchContacts(criteria, SEARCH_RESULT_LIMIT, stored)) {
+        return false;
+    }
+
+    mergeStoredResults(stored, results);
+    return true;
+}
+
+bool ContactPager::searchAllFields(const std::string& query, std::vector<Contact>& results) {
+    results = phonebook.searchAllFields(query);
+    if (exhausted) {
+        return true;
+    }
+
+    std::vector<int> ids;
+    if (!source.searchAllFields(query, TYPE_AHEAD_LIMIT, ids)) {
+        return false;
+    }
+
+    ids.erase(std::remove_if(ids.begin(), ids.end(), [this](const int id) { return isKnownLocally(id); }),
+              ids.end());
+
+    std::vector<Contact> stored;
+    if (!source.fetchContacts(ids, stored)) {
+        return false;
+    }
+
+    mergeStoredResults(stored, results);
+    return true;
+}
+
+bool ContactPager::isEmailUnique(const std::string& email, const int ignoreId, bool& unique) {
+    unique = phonebook.isEmailUnique(email, ignoreId);
+    if (!unique || exhausted) {
+        return true;
+    }
+
+    std::vector<int> ids;
+    if (!source.findEmailOwners(email, ids)) {
+        return false;
+    }
+
+    unique = !hasStoredOwner(ids, ignoreId);
+    return true;
+}
+
+bool ContactPager::isPhoneNumberUnique(const std::string& number, const int ignoreId, bool& unique) {
+    unique = phonebook.isPhoneNumberUnique(number, ignoreId);
+    if (!unique || exhausted) {
+        return true;
+    }
+
+    std::vector<int> ids;
+    if (!source.findPhoneOwners(number, ids)) {
+        return false;
+    }
+
+    unique = !hasStoredOwner(ids, ignoreId);
+    return true;
+}
+
+bool ContactPager::hasStoredOwner(const std::vector<int>& ids, const int ignoreId) const {
+    return std::any_of(ids.begin(), ids.end(),
+                       [this, ignoreId](const int id) { return id != ignoreId && !isKnownLocally(id); });
+}
+
+void ContactPager::mergeStoredResults(std::vector<Contact>& stored, std::vector<Contact>& results) {
+    for (Contact& contact : stored) {
+        if (isKnownLocally(contact.getId())) {
+            continue;
+        }
+        phonebook.addContactFromStorage(contact);
+        results.push_back(std::move(contact));
+    }
+}
+
+bool ContactPager::isKnownLocally(const int id) const {
+    return phonebook.findContact(id) != nullptr || phonebook.wasDeleted(id);
+}
+
+bool ContactPager::isExhausted() const {
+    return exhausted;
+}
+
+std::string ContactPager::getLastError() const {
+    return source.getLastError();
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "PagedContactSource.h"
+#include "Phonebook.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class ContactPager {
+    PagedContactSource& source;
+    Phonebook& phonebook;
+    int pageSize;
+    int lastId = 0;
+    bool exhausted = false;
+
+    bool isKnownLocally(int id) const;
+    bool hasStoredOwner(const std::vector<int>& ids, int ignoreId) const;
+    void mergeStoredResults(std::vector<Contact>& stored, std::vector<Contact>& results);
+
+public:
+    ContactPager(PagedContactSource& source, Phonebook& phonebook, int pageSize = 200);
+
+    bool start();
+    bool fetchNextPage(std::vector<Contact>& page);
+    bool isExhausted() const;
+
+    bool search(const std::map<SearchField, std::string>& criteria, std::vector<Contact>& results);
+    bool searchAllFields(const std::string& query, std::vector<Contact>& results);
+
+    bool isEmailUnique(const std::string& email, int ignoreId, bool& unique);
+    bool isPhoneNumberUnique(const std::string& number, int ignoreId, bool& unique);
+
+    std::string getLastError() const;
+};
@@ -0,0 +1,142 @@
+#include "ContactRowReader.h"
+#include "validation.h"
+#include <utility>
+
+bool ContactRowReader::readContact(const QSqlQuery& query, Contact& contact) {
+    bool ok;
+    const int id = query.value(0).toInt(&ok);
+    if (!ok || id <= 0) {
+        lastError = "Invalid ID found (must be positive integer).";
+        return false;
+    }
+    if (!loadedIds.insert(id).second) {
+        lastError = "Duplicate ID found: " + std::to_string(id);
+        return false;
+    }
+    contact.setId(id);
+
+    std::string surname = validation::trim(query.value(1).toString().toStdString());
+    if (!validation::isValidName(surname)) {
+        lastError = "Invalid surname for ID " + std::to_string(id);
+        return false;
+    }
+    contact.setSurname(surname);
+
+    std::string forename = validation::trim(query.value(2).toString().toStdString());
+    if (!validation::isValidName(forename)) {
+        lastError = "Invalid forename for ID " + std::to_string(id);
+        return false;
+    }
+    contact.setForename(forename);
+
+    std::string patronymic = validation::trim(query.value(3).toString().toStdString());
+    if (!patronymic.empty() && !validation::isValidName(patronymic)) {
+        lastError = "Invalid patronymic for ID " + std::to_string(id);
+        return false;
+    }
+    contact.setPatronymic(patronymic);
+
+    std::string address = validation::trim(query.value(4).toString().toStdString());
+    if (!validation::isValidAddress(address)) {
+        lastError = "Invalid address for ID " + std::to_string(id);
+        return false;
+    }
+    contact.setAddress(address);
+
+    const int day = query.value(5).toInt();
+    const int month = query.value(6).toInt();
+    const int year = query.value(7).toInt();
+
+    if (!(day == 0 && month == 0 && year == 0)) {
+        if (!validation::isValidDate(day, month, year)) {
+            lastError = "Invalid birth date for ID " + std::to_string(id);
+            return false;
+        }
+    }
+    contact.setBirthDate(Date(day, month, year));
+
+    std::string email = validation::trim(query.value(8).toString().toStdString());
+    if (!validation::isValidEmail(email)) {
+        lastError = "Invalid email for ID " + std::to_string(id);
+        return false;
+    }
+    if (!validation::isForenameInEmail(email, forename)) {
+        lastError = "Email does not contain forename for ID " + std::to_string(id);
+        return false;
+    }
+
+    std::string normalizedEmail = validation::normalizeEmail(email);
+    if (!loadedEmails.insert(normalizedEmail).second) {
+        lastError = "Duplicate email found for ID " + std::to_string(id);
+        return false;
+    }
+    contact.setEmail(normalizedEmail);
+    return true;
+}
+
+bool ContactRowReader::readPhone(const QSqlQuery& phoneQuery, Contact& contact) {
+    const int id = contact.getId();
+    const std::string type = validation::trim(phoneQuery.value(1).toString().toStdString());
+    const std::string number = validation::trim(phoneQuery.value(2).toString().toStdString());
+
+    if (!validation::isValidPhoneType(type)) {
+        lastError = "Invalid phone type for ID " + std::to_string(id);
+        return false;
+    }
+    if (!validation::isValidPhoneNumber(number)) {
+        lastError = "Invalid phone number for ID " + std::to_string(id);
+        return false;
+    }
+
+    std::string normalizedNumber = validation::normalizePhoneNumber(number);
+    if (!loadedPhoneNumbers.insert(normalizedNumber).second) {
+        lastError = "Duplicate phone number found for ID " + std::to_string(id);
+        return false;
+    }
+
+    contact.addPhoneNumber(type, normalizedNumber);
+    return true;
+}
+
+bool ContactRowReader::checkPhones(const Contact& contact) {
+    if (contact.getPhoneNumbers().empty()) {
+        lastError = "Contact must have at least one phone number. ID: " + std::to_string(contact.getId());
+        return false;
+    }
+    return true;
+}
+
+bool ContactRowReader::readAll(QSqlQuery& query, QSqlQuery& phoneQuery, ContactVisitor& visitor) {
+    bool hasPhone = phoneQuery.next();
+
+    while (query.next()) {
+        Contact contact;
+        if (!readContact(query, contact)) {
+            return false;
+        }
+
+        const int id = contact.getId();
+        while (hasPhone && phoneQuery.value(0).toInt() < id) {
+            hasPhone = phoneQuery.next();
+        }
+
+        while (hasPhone && phoneQuery.value(0).toInt() == id) {
+            if (!readPhone(phoneQuery, contact)) {
+                return false;
+            }
+            hasPhone = phoneQuery.next();
+        }
+
+        if (!checkPhones(contact)) {
+            return false;
+        }
+
+        visitor.visit(std::move(contact));
+    }
+
+    return true;
+}
+
+std::string ContactRowReader::getLastError() const {
+    return lastError;
+}
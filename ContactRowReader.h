@@ -0,0 +1,22 @@
+#pragma once
+#include "Contact.h"
+#include "ContactStorage.h"
+#include <QSqlQuery>
+#include <string>
+#include <unordered_set>
+
+class ContactRowReader {
+    std::unordered_set<int> loadedIds;
+    std::unordered_set<std::string> loadedEmails;
+    std::unordered_set<std::string> loadedPhoneNumbers;
+    std::string lastError;
+
+public:
+    bool readContact(const QSqlQuery& query, Contact& contact);
+    bool readPhone(const QSqlQuery& phoneQuery, Contact& contact);
+    bool checkPhones(const Contact& contact);
+
+    bool readAll(QSqlQuery& query, QSqlQuery& phoneQuery, ContactVisitor& visitor);
+
+    std::string getLastError() const;
+};
@@ -0,0 +1,128 @@
+#include "ContactRowWriter.h"
+#include <QSqlError>
+#include <utility>
+
+namespace {
+    constexpr const char* INSERT_CONTACT =
+        "INSERT INTO contacts (id, surname, forename, patronymic, address, birth_day, birth_month, birth_year, email) "
+        "VALUES (:id, :surname, :forename, :patronymic, :address, :birth_day, :birth_month, :birth_year, :email)";
+    constexpr const char* UPSERT_CONTACT_UPDATE =
+        " ON CONFLICT (id) DO UPDATE SET surname = EXCLUDED.surname, forename = EXCLUDED.forename, "
+        "patronymic = EXCLUDED.patronymic, address = EXCLUDED.address, birth_day = EXCLUDED.birth_day, "
+        "birth_month = EXCLUDED.birth_month, birth_year = EXCLUDED.birth_year, email = EXCLUDED.email";
+    constexpr const char* INSERT_PHONE =
+        "INSERT INTO phones (contact_id, type, number) VALUES (:contact_id, :type, :number)";
+}
+
+ContactRowWriter::ContactRowWriter(QSqlDatabase database) : database(std::move(database)) {}
+
+void ContactRowWriter::begin() {
+    database.transaction();
+}
+
+bool ContactRowWriter::commit() {
+    if (!database.commit()) {
+        lastError = database.lastError().text().toStdString();
+        return false;
+    }
+    return true;
+}
+
+bool ContactRowWriter::exec(QSqlQuery& query) {
+    if (!query.exec()) {
+        lastError = query.lastError().text().toStdString();
+        database.rollback();
+        return false;
+    }
+    return true;
+}
+
+bool ContactRowWriter::exec(const char* statement) {
+    QSqlQuery query(database);
+    if (!query.exec(statement)) {
+        lastError = query.lastError().text().toStdString();
+        database.rollback();
+        return false;
+    }
+    return true;
+}
+
+bool ContactRowWriter::insertContacts(const ContactProducer& producer) {
+    QSqlQuery contactQuery(database);
+    contactQuery.prepare(INSERT_CONTACT);
+
+    QSqlQuery phoneQuery(database);
+    phoneQuery.prepare(INSERT_PHONE);
+
+    while (const Contact* contact = producer()) {
+        bindContact(contactQuery, *contact);
+
+        if (!exec(contactQuery) || !insertPhones(phoneQuery, *contact)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ContactRowWriter::applyChanges(const ContactChanges& changes) {
+    QSqlQuery deleteQuery(database);
+    deleteQuery.prepare("DELETE FROM contacts WHERE id = :id");
+
+    for (const int id : changes.deletedIds) {
+        deleteQuery.bindValue(":id", id);
+        if (!exec(deleteQuery)) {
+            return false;
+        }
+    }
+
+    QSqlQuery upsertQuery(database);
+    upsertQuery.prepare(QString(INSERT_CONTACT) + UPSERT_CONTACT_UPDATE);
+
+    QSqlQuery deletePhonesQuery(database);
+    deletePhonesQuery.prepare("DELETE FROM phones WHERE contact_id = :contact_id");
+
+    QSqlQuery phoneQuery(database);
+    phoneQuery.prepare(INSERT_PHONE);
+
+    for (const auto& contact : changes.upserted) {
+        bindContact(upsertQuery, contact);
+        deletePhonesQuery.bindValue(":contact_id", contact.getId());
+
+        if (!exec(upsertQuery) || !exec(deletePhonesQuery) || !insertPhones(phoneQuery, contact)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ContactRowWriter::bindContact(QSqlQuery& query, const Contact& contact) {
+    query.bindValue(":id", contact.getId());
+    query.bindValue(":surname", QString::fromStdString(contact.getSurname()));
+    query.bindValue(":forename", QString::fromStdString(contact.getForename()));
+    query.bindValue(":patronymic", QString::fromStdString(contact.getPatronymic()));
+    query.bindValue(":address", QString::fromStdString(contact.getAddress()));
+
+    const Date birthDate = contact.getBirthDate();
+    query.bindValue(":birth_day", birthDate.day);
+    query.bindValue(":birth_month", birthDate.month);
+    query.bindValue(":birth_year", birthDate.year);
+
+    query.bindValue(":email", QString::fromStdString(contact.getEmail()));
+}
+
+bool ContactRowWriter::insertPhones(QSqlQuery& phoneQuery, const Contact& contact) {
+    for (const auto& phone : contact.getPhoneNumbers()) {
+        phoneQuery.bindValue(":contact_id", contact.getId());
+        phoneQuery.bindValue(":type", QString::fromStdString(phone.type));
+        phoneQuery.bindValue(":number", QString::fromStdString(phone.number));
+
+        if (!exec(phoneQuery)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string ContactRowWriter::getLastError() const {
+    return lastError;
+}
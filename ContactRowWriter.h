@@ -0,0 +1,27 @@
+#pragma once
+#include "Contact.h"
+#include "ContactStorage.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <string>
+
+class ContactRowWriter {
+    QSqlDatabase database;
+    std::string lastError;
+
+    static void bindContact(QSqlQuery& query, const Contact& contact);
+    bool insertPhones(QSqlQuery& phoneQuery, const Contact& contact);
+
+public:
+    explicit ContactRowWriter(QSqlDatabase database);
+
+    void begin();
+    bool commit();
+    bool exec(QSqlQuery& query);
+    bool exec(const char* statement);
+
+    bool insertContacts(const ContactProducer& producer);
+    bool applyChanges(const ContactChanges& changes);
+
+    std::string getLastError() const;
+};
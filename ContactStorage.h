@@ -1,14 +1,65 @@
 #pragma once
 #include "Contact.h"
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
+struct ContactChanges {
+    bool fullRewrite = true;
+    bool orderChanged = false;
+    std::vector<Contact> upserted;
+    std::vector<int> deletedIds;
+};
+
+class ContactVisitor {
+public:
+    virtual ~ContactVisitor() = default;
+
+    virtual void reserve(size_t) {}
+    virtual void visit(Contact&& contact) = 0;
+};
+
+using ContactProducer = std::function<const Contact*()>;
+
 class ContactStorage {
 public:
     virtual ~ContactStorage() = default;
 
-    virtual std::vector<Contact> load() = 0;
-    virtual bool save(const std::vector<Contact>& contacts) = 0;
+    virtual bool loadInto(ContactVisitor& visitor) = 0;
+    virtual bool saveFrom(const ContactProducer& producer) = 0;
+
+    std::vector<Contact> load() {
+        class Collector : public ContactVisitor {
+        public:
+            std::vector<Contact> contacts;
+
+            void reserve(const size_t count) override {
+                contacts.reserve(count);
+            }
+
+            void visit(Contact&& contact) override {
+                contacts.push_back(std::move(contact));
+            }
+        };
+
+        Collector collector;
+        if (!loadInto(collector)) {
+            return {};
+        }
+        return std::move(collector.contacts);
+    }
+
+    bool save(const std::vector<Contact>& contacts) {
+        size_t next = 0;
+        return saveFrom([&contacts, &next]() -> const Contact* {
+            return next < contacts.size() ? &contacts[next++] : nullptr;
+        });
+    }
+
+    virtual bool saveChanges(const std::vector<Contact>& contacts, const ContactChanges&) {
+        return save(contacts);
+    }
 
     virtual std::string getLastError() const {
         return lastError;
@@ -16,4 +67,4 @@ public:
 
 protected:
     std::string lastError;
-};
\ No newline at end of file
+};
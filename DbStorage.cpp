@@ -3,9 +3,50 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
-#include <set>
+#include <algorithm>
+#include <cctype>
 #include <utility>
 
+namespace {
+    constexpr size_t MAX_BIND_PARAMETERS = 65535;
+    constexpr size_t SAVE_CHUNK_SIZE = 8192;
+    constexpr const char* CONTACT_COLUMNS =
+        "c.id, c.surname, c.forename, c.patronymic, c.address, c.birth_day, c.birth_month, c.birth_year, c.email";
+
+    std::string likeContainsPattern(const std::string& query) {
+        std::string pattern = "%";
+        for (const char c : query) {
+            if (c == '%' || c == '_' || c == '\\') {
+                pattern += '\\';
+            }
+            pattern += c;
+        }
+        pattern += '%';
+        return pattern;
+    }
+
+    bool parseSearchNumber(const std::string& query, int& value) {
+        try {
+            value = std::stoi(query);
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    std::string buildMultiRowInsert(const std::string& insertHead, const size_t rows, const size_t columns) {
+        std::string sql = insertHead + " VALUES ";
+        for (size_t row = 0; row < rows; ++row) {
+            sql += row == 0 ? "(" : ", (";
+            for (size_t column = 0; column < columns; ++column) {
+                sql += column == 0 ? "?" : ", ?";
+            }
+            sql += ')';
+        }
+        return sql;
+    }
+}
+
 DbStorage::DbStorage(std::string host, const int port, std::string databaseName, std::string user,
                      std::string password) : host(std::move(host)), port(port), databaseName(std::move(databaseName)),
                                              user(std::move(user)), password(std::move(password)) {}
@@ -16,6 +57,14 @@ DbStorage::~DbStorage() {
     }
 }
 
+void DbStorage::setBatchSize(const int size) {
+    batchSize = std::max(1, size);
+}
+
+int DbStorage::getBatchSize() const {
+    return batchSize;
+}
+
 bool DbStorage::init() {
     database = QSqlDatabase::addDatabase("QPSQL");
 
@@ -33,192 +82,487 @@ bool DbStorage::init() {
     return createTables();
 }
 
-std::vector<Contact> DbStorage::load() {
-    std::vector<Contact> contacts;
+bool DbStorage::loadInto(ContactVisitor& visitor) {
     if (!database.isOpen()) {
-        return contacts;
+        return true;
     }
 
-    std::set<int> loadedIds;
-    std::set<std::string> loadedEmails;
-    std::set<std::string> loadedPhoneNumbers;
+    QSqlQuery query;
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT " + QString(CONTACT_COLUMNS) + " FROM contacts c ORDER BY c.id")) {
+        lastError = query.lastError().text().toStdString();
+        return false;
+    }
 
-    QSqlQuery query("SELECT * FROM contacts ORDER BY id");
     QSqlQuery phoneQuery;
+    phoneQuery.setForwardOnly(true);
+    if (!phoneQuery.exec("SELECT contact_id, type, number FROM phones ORDER BY contact_id, id")) {
+        lastError = phoneQuery.lastError().text().toStdString();
+        return false;
+    }
 
-    while (query.next()) {
-        Contact contact;
+    ContactRowReader reader;
+    if (!reader.readAll(query, phoneQuery, visitor)) {
+        lastError = reader.getLastError();
+        return false;
+    }
+    return true;
+}
 
-        bool ok;
-        int id = query.value("id").toInt(&ok);
-        if (!ok || id <= 0) {
-            lastError = "Invalid ID found (must be positive integer).";
-            return {};
-        }
-        if (loadedIds.count(id)) {
-            lastError = "Duplicate ID found: " + std::to_string(id);
-            return {};
+bool DbStorage::saveFrom(const ContactProducer& producer) {
+    if (!database.isOpen()) {
+        return false;
+    }
+
+    ContactRowWriter writer(database);
+    writer.begin();
+
+    if (!writer.exec("TRUNCATE TABLE contacts RESTART IDENTITY CASCADE")) {
+        lastError = writer.getLastError();
+        return false;
+    }
+
+    if (batchSize <= 1) {
+        if (!writer.insertContacts(producer) || !writer.commit()) {
+            lastError = writer.getLastError();
+            return false;
         }
-        loadedIds.insert(id);
-        contact.setId(id);
-
-        std::string surname = query.value("surname").toString().toStdString();
-        surname = validation::trim(surname);
-        if (!validation::isValidName(surname)) {
-            lastError = "Invalid surname for ID " + std::to_string(id);
-            return {};
+        return true;
+    }
+
+    std::vector<Contact> chunk;
+    chunk.reserve(SAVE_CHUNK_SIZE);
+    while (true) {
+        chunk.clear();
+        while (chunk.size() < SAVE_CHUNK_SIZE) {
+            const Contact* contact = producer();
+            if (contact == nullptr) {
+                break;
+            }
+            chunk.push_back(*contact);
         }
-        contact.setSurname(surname);
 
-        std::string forename = query.value("forename").toString().toStdString();
-        forename = validation::trim(forename);
-        if (!validation::isValidName(forename)) {
-            lastError = "Invalid forename for ID " + std::to_string(id);
-            return {};
+        if (chunk.empty()) {
+            break;
         }
-        contact.setForename(forename);
+        if (!insertContactsBatched(writer, chunk)) {
+            lastError = writer.getLastError();
+            return false;
+        }
+    }
+
+    if (!writer.commit()) {
+        lastError = writer.getLastError();
+        return false;
+    }
+    return true;
+}
+
+bool DbStorage::insertContactsBatched(ContactRowWriter& writer, const std::vector<Contact>& contacts) {
+    const bool contactsInserted = insertBatched(
+        writer,         "INSERT INTO contacts (id, surname, forename, patronymic, address, birth_day, birth_month, birth_year, email)",
+        9, contacts.size(),
+        [&contacts](QSqlQuery& query, const int firstParam, const size_t row) {
+            const Contact& contact = contacts[row];
+            const Date birthDate = contact.getBirthDate();
+
+            query.bindValue(firstParam, contact.getId());
+            query.bindValue(firstParam + 1, QString::fromStdString(contact.getSurname()));
+            query.bindValue(firstParam + 2, QString::fromStdString(contact.getForename()));
+            query.bindValue(firstParam + 3, QString::fromStdString(contact.getPatronymic()));
+            query.bindValue(firstParam + 4, QString::fromStdString(contact.getAddress()));
+            query.bindValue(firstParam + 5, birthDate.day);
+            query.bindValue(firstParam + 6, birthDate.month);
+            query.bindValue(firstParam + 7, birthDate.year);
+            query.bindValue(firstParam + 8, QString::fromStdString(contact.getEmail()));
+        });
+    if (!contactsInserted) {
+        return false;
+    }
 
-        std::string patronymic = query.value("patronymic").toString().toStdString();
-        patronymic = validation::trim(patronymic);
-        if (!patronymic.empty() && !validation::isValidName(patronymic)) {
-            lastError = "Invalid patronymic for ID " + std::to_string(id);
-            return {};
+    std::vector<std::pair<int, PhoneNumber>> phones;
+    for (const auto& contact : contacts) {
+        for (const auto& phone : contact.getPhoneNumbers()) {
+            phones.emplace_back(contact.getId(), phone);
         }
-        contact.setPatronymic(patronymic);
+    }
+
+    return insertBatched(
+        writer, "INSERT INTO phones (contact_id, type, number)", 3, phones.size(),
+        [&phones](QSqlQuery& query, const int firstParam, const size_t row) {
+            query.bindValue(firstParam, phones[row].first);
+            query.bindValue(firstParam + 1, QString::fromStdString(phones[row].second.type));
+            query.bindValue(firstParam + 2, QString::fromStdString(phones[row].second.number));
+        });
+}
+
+bool DbStorage::insertBatched(ContactRowWriter& writer, const std::string& insertHead, const size_t columns,
+                              const size_t rowCount, const std::function<void(QSqlQuery&, int, size_t)>& bindRow) {
+    const size_t rowsPerBatch = std::min(static_cast<size_t>(batchSize), MAX_BIND_PARAMETERS / columns);
 
-        std::string address = query.value("address").toString().toStdString();
-        address = validation::trim(address);
-        if (!validation::isValidAddress(address)) {
-            lastError = "Invalid address for ID " + std::to_string(id);
-            return {};
+    QSqlQuery query(database);
+    size_t preparedRows = 0;
+
+    for (size_t first = 0; first < rowCount; first += rowsPerBatch) {
+        const size_t rows = std::min(rowsPerBatch, rowCount - first);
+        if (rows != preparedRows) {
+            query.prepare(QString::fromStdString(buildMultiRowInsert(insertHead, rows, columns)));
+            preparedRows = rows;
         }
-        contact.setAddress(address);
 
-        int day = query.value("birth_day").toInt();
-        int month = query.value("birth_month").toInt();
-        int year = query.value("birth_year").toInt();
+        for (size_t row = 0; row < rows; ++row) {
+            bindRow(query, static_cast<int>(row * columns), first + row);
+        }
 
-        if (!(day == 0 && month == 0 && year == 0)) {
-            if (!validation::isValidDate(day, month, year)) {
-                lastError = "Invalid birth date for ID " + std::to_string(id);
-                return {};
-            }
+        if (!writer.exec(query)) {
+            return false;
         }
-        contact.setBirthDate(Date(day, month, year));
+    }
+    return true;
+}
+
+bool DbStorage::saveChanges(const std::vector<Contact>& contacts, const ContactChanges& changes) {
+    if (changes.fullRewrite) {
+        return save(contacts);
+    }
+
+    if (!database.isOpen()) {
+        return false;
+    }
+
+    ContactRowWriter writer(database);
+    writer.begin();
+
+    if (!writer.applyChanges(changes) || !writer.commit()) {
+        lastError = writer.getLastError();
+        return false;
+    }
+    return true;
+}
 
-        std::string email = query.value("email").toString().toStdString();
-        email = validation::trim(email);
-        if (!validation::isValidEmail(email)) {
-            lastError = "Invalid email for ID " + std::to_string(id);
-            return {};
+bool DbStorage::fetchPage(const int afterId, const int limit, std::vector<Contact>& page) {
+    page.clear();
+    if (!database.isOpen()) {
+        lastError = "Database is not open.";
+        return false;
+    }
+
+    QSqlQuery query;
+    query.setForwardOnly(true);
+    query.prepare("SELECT " + QString(CONTACT_COLUMNS) + " FROM contacts c WHERE c.id > :last ORDER BY c.id LIMIT :limit");
+    query.bindValue(":last", afterId);
+    query.bindValue(":limit", limit);
+
+    if (!query.exec()) {
+        lastError = query.lastError().text().toStdString();
+        return false;
+    }
+
+    if (!readContacts(query, page)) {
+        page.clear();
+        return false;
+    }
+    return true;
+}
+
+bool DbStorage::searchContacts(const std::map<SearchField, std::string>& criteria, const int limit,
+                               std::vector<Contact>& results) {
+    results.clear();
+    if (!database.isOpen()) {
+        lastError = "Database is not open.";
+        return false;
+    }
+
+    std::string sql = "SELECT " + std::string(CONTACT_COLUMNS) + " FROM contacts c WHERE TRUE";
+    std::vector<QVariant> values;
+
+    const auto addTextCondition = [&sql, &values](const std::string& column, const std::string& query) {
+        sql += " AND c.search_text LIKE ? AND strpos(lower(" + column + "), ?) > 0";
+        values.emplace_back(QString::fromStdString(likeContainsPattern(query)));
+        values.emplace_back(QString::fromStdString(query));
+    };
+
+    for (const auto& [field, value] : criteria) {
+        std::string query = validation::trim(value);
+        if (query.empty()) {
+            continue;
         }
-        if (!validation::isForenameInEmail(email, forename)) {
-            lastError = "Email does not contain forename for ID " + std::to_string(id);
-            return {};
+
+        if (field != SearchField::PHONE) {
+            std::transform(query.begin(), query.end(), query.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
         }
 
-        std::string normalizedEmail = validation::normalizeEmail(email);
-        if (loadedEmails.count(normalizedEmail)) {
-            lastError = "Duplicate email found for ID " + std::to_string(id);
-            return {};
+        int number = 0;
+        switch (field) {
+            case SearchField::ID:
+                if (!parseSearchNumber(query, number)) {
+                    return true;
+                }
+                sql += " AND c.id = ?";
+                values.emplace_back(number);
+                break;
+            case SearchField::SURNAME:
+                addTextCondition("c.surname", query);
+                break;
+            case SearchField::FORENAME:
+                addTextCondition("c.forename", query);
+                break;
+            case SearchField::PATRONYMIC:
+                addTextCondition("c.patronymic", query);
+                break;
+            case SearchField::ADDRESS:
+                addTextCondition("c.address", query);
+                break;
+            case SearchField::BIRTH_DAY:
+                if (!parseSearchNumber(query, number)) {
+                    return true;
+                }
+                sql += " AND c.birth_day <> 0 AND c.birth_day = ?";
+                values.emplace_back(number);
+                break;
+            case SearchField::BIRTH_MONTH:
+                if (!parseSearchNumber(query, number)) {
+                    return true;
+                }
+                sql += " AND c.birth_month <> 0 AND c.birth_month = ?";
+                values.emplace_back(number);
+                break;
+            case SearchField::BIRTH_YEAR:
+                if (!parseSearchNumber(query, number)) {
+                    return true;
+                }
+                sql += " AND c.birth_year <> 0 AND c.birth_year = ?";
+                values.emplace_back(number);
+                break;
+            case SearchField::EMAIL:
+                addTextCondition("c.email", query);
+                break;
+            case SearchField::PHONE: {
+                const std::string digits = validation::phoneSearchDigits(query);
+                if (digits.empty()) {
+                    return true;
+                }
+                sql += " AND EXISTS (SELECT 1 FROM phones p WHERE p.contact_id = c.id AND p.digits LIKE ?)";
+                values.emplace_back(QString::fromStdString(likeContainsPattern(digits)));
+                break;
+            }
         }
-        loadedEmails.insert(normalizedEmail);
-        contact.setEmail(normalizedEmail);
+    }
+    sql += " ORDER BY c.id LIMIT ?";
+    values.emplace_back(limit);
 
-        phoneQuery.exec("SELECT type, number FROM phones WHERE contact_id = " + QString::number(id));
+    QSqlQuery query;
+    query.setForwardOnly(true);
+    query.prepare(QString::fromStdString(sql));
+    for (size_t i = 0; i < values.size(); ++i) {
+        query.bindValue(static_cast<int>(i), values[i]);
+    }
 
-        while (phoneQuery.next()) {
-            std::string type = phoneQuery.value("type").toString().toStdString();
-            std::string number = phoneQuery.value("number").toString().toStdString();
+    if (!query.exec()) {
+        lastError = query.lastError().text().toStdString();
+        return false;
+    }
 
-            type = validation::trim(type);
-            number = validation::trim(number);
+    if (!readContacts(query, results)) {
+        results.clear();
+        return false;
+    }
+    return true;
+}
 
-            if (!validation::isValidPhoneType(type)) {
-                lastError = "Invalid phone type for ID " + std::to_string(id);
-                return {};
-            }
-            if (!validation::isValidPhoneNumber(number)) {
-                lastError = "Invalid phone number for ID " + std::to_string(id);
-                return {};
-            }
+bool DbStorage::readContacts(QSqlQuery& query, std::vector<Contact>& contacts) {
+    ContactRowReader reader;
+    while (query.next()) {
+        Contact contact;
+        if (!reader.readContact(query, contact)) {
+            lastError = reader.getLastError();
+            return false;
+        }
+        contacts.push_back(std::move(contact));
+    }
 
-            std::string normalizedNumber = validation::normalizePhoneNumber(number);
-            if (loadedPhoneNumbers.count(normalizedNumber)) {
-                lastError = "Duplicate phone number found for ID " + std::to_string(id);
-                return {};
-            }
-            loadedPhoneNumbers.insert(normalizedNumber);
+    if (!attachPhones(reader, contacts)) {
+        return false;
+    }
 
-            contact.addPhoneNumber(type, normalizedNumber);
+    for (const Contact& contact : contacts) {
+        if (!reader.checkPhones(contact)) {
+            lastError = reader.getLastError();
+            return false;
         }
+    }
+    return true;
+}
+
+bool DbStorage::attachPhones(ContactRowReader& reader, std::vector<Contact>& contacts) {
+    if (contacts.empty()) {
+        return true;
+    }
+
+    std::string placeholders;
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        placeholders += i == 0 ? "?" : ", ?";
+    }
+
+    QSqlQuery phoneQuery;
+    phoneQuery.setForwardOnly(true);
+    phoneQuery.prepare(QString::fromStdString("SELECT contact_id, type, number FROM phones WHERE contact_id IN (" +
+                                              placeholders + ") ORDER BY contact_id, id"));
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        phoneQuery.bindValue(static_cast<int>(i), contacts[i].getId());
+    }
 
-        if (contact.getPhoneNumbers().empty()) {
-            lastError = "Contact must have at least one phone number. ID: " + std::to_string(id);
-            return {};
+    if (!phoneQuery.exec()) {
+        lastError = phoneQuery.lastError().text().toStdString();
+        return false;
+    }
+
+    auto contactIt = contacts.begin();
+    while (phoneQuery.next()) {
+        const int contactId = phoneQuery.value(0).toInt();
+        while (contactIt != contacts.end() && contactIt->getId() < contactId) {
+            ++contactIt;
+        }
+        if (contactIt == contacts.end()) {
+            break;
         }
+        if (contactIt->getId() == contactId && !reader.readPhone(phoneQuery, *contactIt)) {
+            lastError = reader.getLastError();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DbStorage::fetchMaxId(int& maxId) {
+    if (!database.isOpen()) {
+        lastError = "Database is not open.";
+        return false;
+    }
 
-        contacts.push_back(contact);
+    QSqlQuery query;
+    if (!query.exec("SELECT COALESCE(MAX(id), 0) FROM contacts") || !query.next()) {
+        lastError = query.lastError().text().toStdString();
+        return false;
     }
 
-    return contacts;
+    maxId = query.value(0).toInt();
+    return true;
 }
 
-bool DbStorage::save(const std::vector<Contact>& contacts) {
+bool DbStorage::searchAllFields(const std::string& query, const int limit, std::vector<int>& ids) {
+    ids.clear();
     if (!database.isOpen()) {
+        lastError = "Database is not open.";
         return false;
     }
 
-    database.transaction();
+    const std::string trimmedQuery = validation::trim(query);
+    if (trimmedQuery.empty()) {
+        return true;
+    }
+    const std::string queryDigits = validation::phoneSearchDigits(trimmedQuery);
+
+    std::string sql = "(SELECT id FROM contacts WHERE search_text LIKE lower(?) ORDER BY id LIMIT ?)";
+    if (!queryDigits.empty()) {
+        sql += " UNION (SELECT DISTINCT contact_id FROM phones WHERE digits LIKE ? ORDER BY contact_id LIMIT ?)";
+    }
+    sql += " ORDER BY 1 LIMIT ?";
+
+    QSqlQuery searchQuery;
+    searchQuery.setForwardOnly(true);
+    searchQuery.prepare(QString::fromStdString(sql));
+
+    int position = 0;
+    searchQuery.bindValue(position++, QString::fromStdString(likeContainsPattern(trimmedQuery)));
+    searchQuery.bindValue(position++, limit);
+    if (!queryDigits.empty()) {
+        searchQuery.bindValue(position++, QString::fromStdString(likeContainsPattern(queryDigits)));
+        searchQuery.bindValue(position++, limit);
+    }
+    searchQuery.bindValue(position, limit);
+
+    if (!searchQuery.exec()) {
+        lastError = searchQuery.lastError().text().toStdString();
+        return false;
+    }
+
+    while (searchQuery.next()) {
+        ids.push_back(searchQuery.value(0).toInt());
+    }
+    return true;
+}
+
+bool DbStorage::findEmailOwners(const std::string& email, std::vector<int>& ids) {
+    return findOwners("SELECT id FROM contacts WHERE lower(email) = ?", validation::normalizeEmail(email), ids);
+}
+
+bool DbStorage::findPhoneOwners(const std::string& number, std::vector<int>& ids) {
+    return findOwners("SELECT DISTINCT contact_id FROM phones WHERE digits = ?",
+                      validation::phoneSearchDigits(number), ids);
+}
+
+bool DbStorage::findOwners(const char* sql, const std::string& key, std::vector<int>& ids) {
+    ids.clear();
+    if (!database.isOpen()) {
+        lastError = "Database is not open.";
+        return false;
+    }
 
     QSqlQuery query;
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    query.bindValue(0, QString::fromStdString(key));
 
-    if (!query.exec("TRUNCATE TABLE contacts RESTART IDENTITY CASCADE")) {
+    if (!query.exec()) {
         lastError = query.lastError().text().toStdString();
-        database.rollback();
         return false;
     }
 
-    query.prepare("INSERT INTO contacts (id, surname, forename, patronymic, address, birth_day, birth_month, birth_year, email) "
-                  "VALUES (:id, :surname, :forename, :patronymic, :address, :birth_day, :birth_month, :birth_year, :email)");
-
-    QSqlQuery phoneQuery;
-    phoneQuery.prepare("INSERT INTO phones (contact_id, type, number) VALUES (:contact_id, :type, :number)");
+    while (query.next()) {
+        ids.push_back(query.value(0).toInt());
+    }
+    return true;
+}
 
-    for (const auto& contact : contacts) {
-        query.bindValue(":id", contact.getId());
-        query.bindValue(":surname", QString::fromStdString(contact.getSurname()));
-        query.bindValue(":forename", QString::fromStdString(contact.getForename()));
-        query.bindValue(":patronymic", QString::fromStdString(contact.getPatronymic()));
-        query.bindValue(":address", QString::fromStdString(contact.getAddress()));
+bool DbStorage::fetchContacts(const std::vector<int>& ids, std::vector<Contact>& contacts) {
+    contacts.clear();
+    if (!database.isOpen()) {
+        lastError = "Database is not open.";
+        return false;
+    }
+    if (ids.empty()) {
+        return true;
+    }
 
-        const Date birthDate = contact.getBirthDate();
-        query.bindValue(":birth_day", birthDate.day);
-        query.bindValue(":birth_month", birthDate.month);
-        query.bindValue(":birth_year", birthDate.year);
+    std::string placeholders;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        placeholders += i == 0 ? "?" : ", ?";
+    }
 
-        query.bindValue(":email", QString::fromStdString(contact.getEmail()));
+    QSqlQuery query;
+    query.setForwardOnly(true);
+    query.prepare(QString::fromStdString("SELECT " + std::string(CONTACT_COLUMNS) +
+                                         " FROM contacts c WHERE c.id IN (" + placeholders + ") ORDER BY c.id"));
+    for (size_t i = 0; i < ids.size(); ++i) {
+        query.bindValue(static_cast<int>(i), ids[i]);
+    }
 
-        if (!query.exec()) {
-            lastError = query.lastError().text().toStdString();
-            database.rollback();
-            return false;
-        }
+    if (!query.exec()) {
+        lastError = query.lastError().text().toStdString();
+        return false;
+    }
 
-        for (const auto& phone : contact.getPhoneNumbers()) {
-            phoneQuery.bindValue(":contact_id", contact.getId());
-            phoneQuery.bindValue(":type", QString::fromStdString(phone.type));
-            phoneQuery.bindValue(":number", QString::fromStdString(phone.number));
-
-            if (!phoneQuery.exec()) {
-                lastError = phoneQuery.lastError().text().toStdString();
-                database.rollback();
-                return false;
-            }
-        }
+    if (!readContacts(query, contacts)) {
+        contacts.clear();
+        return false;
     }
+    return true;
+}
 
-    return database.commit();
+std::string DbStorage::getLastError() const {
+    return ContactStorage::getLastError();
 }
 
 bool DbStorage::createTables() {
@@ -255,5 +599,44 @@ bool DbStorage::createTables() {
         return false;
     }
 
+    const char* const schemaUpdates[] = {
+        "ALTER TABLE phones ADD COLUMN IF NOT EXISTS digits TEXT "
+        "GENERATED ALWAYS AS (regexp_replace(number, '[^0-9]', '', 'g')) STORED",
+        "CREATE INDEX IF NOT EXISTS phones_contact_id_idx ON phones (contact_id)",
+        "CREATE INDEX IF NOT EXISTS phones_digits_lookup_idx ON phones (digits)",
+        "CREATE INDEX IF NOT EXISTS contacts_email_lookup_idx ON contacts (lower(email))",
+        "CREATE INDEX IF NOT EXISTS contacts_birth_date_idx ON contacts (birth_year, birth_month, birth_day)",
+        "CREATE INDEX IF NOT EXISTS contacts_birth_month_idx ON contacts (birth_month, birth_day)",
+        "ALTER TABLE contacts ADD COLUMN IF NOT EXISTS search_text TEXT GENERATED ALWAYS AS ("
+        "id::text || chr(31) || lower(surname) || chr(31) || lower(forename) || chr(31) || "
+        "lower(coalesce(patronymic, '')) || chr(31) || lower(coalesce(address, '')) || chr(31) || "
+        "lower(email) || chr(31) || coalesce(birth_day, 0)::text || '.' || "
+        "coalesce(birth_month, 0)::text || '.' || coalesce(birth_year, 0)::text) STORED"
+    };
+
+    for (const char* statement : schemaUpdates) {
+        if (!query.exec(statement)) {
+            lastError = query.lastError().text().toStdString();
+            return false;
+        }
+    }
+
+    if (!query.exec("CREATE EXTENSION IF NOT EXISTS pg_trgm")) {
+        qWarning() << "pg_trgm is unavailable, type-ahead search will not be indexed:" << query.lastError().text();
+        return true;
+    }
+
+    const char* const trigramIndexes[] = {
+        "CREATE INDEX IF NOT EXISTS contacts_search_text_trgm_idx ON contacts USING gin (search_text gin_trgm_ops)",
+        "CREATE INDEX IF NOT EXISTS phones_digits_trgm_idx ON phones USING gin (digits gin_trgm_ops)"
+    };
+
+    for (const char* statement : trigramIndexes) {
+        if (!query.exec(statement)) {
+            lastError = query.lastError().text().toStdString();
+            return false;
+        }
+    }
+
     return true;
 }
@@ -1,18 +1,38 @@
 #pragma once
+#include "ContactRowReader.h"
+#include "ContactRowWriter.h"
 #include "ContactStorage.h"
+#include "PagedContactSource.h"
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <functional>
 #include <string>
 #include <vector>
 
-class DbStorage : public ContactStorage {
+class DbStorage : public ContactStorage, public PagedContactSource {
 public:
     DbStorage(std::string host, int port, std::string databaseName, std::string user, std::string password);
     ~DbStorage() override;
 
     bool init();
 
-    std::vector<Contact> load() override;
-    bool save(const std::vector<Contact>& contacts) override;
+    void setBatchSize(int size);
+    int getBatchSize() const;
+
+    bool loadInto(ContactVisitor& visitor) override;
+    bool saveFrom(const ContactProducer& producer) override;
+    bool saveChanges(const std::vector<Contact>& contacts, const ContactChanges& changes) override;
+
+    bool fetchPage(int afterId, int limit, std::vector<Contact>& page) override;
+    bool fetchMaxId(int& maxId) override;
+    bool searchContacts(const std::map<SearchField, std::string>& criteria, int limit,
+                        std::vector<Contact>& results) override;
+    bool searchAllFields(const std::string& query, int limit, std::vector<int>& ids) override;
+    bool fetchContacts(const std::vector<int>& ids, std::vector<Contact>& contacts) override;
+    bool findEmailOwners(const std::string& email, std::vector<int>& ids) override;
+    bool findPhoneOwners(const std::string& number, std::vector<int>& ids) override;
+
+    std::string getLastError() const override;
 
 private:
     QSqlDatabase database;
@@ -21,6 +41,14 @@ private:
     std::string databaseName;
     std::string user;
     std::string password;
+    int batchSize = 500;
 
     bool createTables();
+
+    bool readContacts(QSqlQuery& query, std::vector<Contact>& contacts);
+    bool attachPhones(ContactRowReader& reader, std::vector<Contact>& contacts);
+    bool findOwners(const char* sql, const std::string& key, std::vector<int>& ids);
+    bool insertContactsBatched(ContactRowWriter& writer, const std::vector<Contact>& contacts);
+    bool insertBatched(ContactRowWriter& writer, const std::string& insertHead, size_t columns, size_t rowCount,
+                       const std::function<void(QSqlQuery&, int, size_t)>& bindRow);
 };
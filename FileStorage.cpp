@@ -1,101 +1,113 @@
 #include "FileStorage.h"
+#include "MappedFile.h"
+#include "fileio.h"
 #include "validation.h"
-#include <fstream>
-#include <set>
-#include <sstream>
-
-bool stringToInt(const std::string& str, int& outValue) {
-    try {
-        size_t pos;
-        outValue = std::stoi(str, &pos);
-        return pos == str.length();
-    } catch (...) {
-        return false;
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+bool stringToInt(const std::string_view str, int& outValue) {
+    size_t pos = 0;
+    while (pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos]))) {
+        ++pos;
     }
-}
-
-std::vector<Contact> FileStorage::load() {
-    lastError.clear();
-    std::vector<Contact> contacts;
-    std::ifstream file(filename);
-
-    if (!file.is_open()) {
-        lastError = "Cannot open file '" + filename + "' for reading.";
-        return contacts;
+    if (pos < str.size() && str[pos] == '+') {
+        ++pos;
+        if (pos < str.size() && str[pos] == '-') {
+            return false;
+        }
     }
 
-    std::string line;
-    int lineNum = 0;
-
-    std::set<int> loadedIds;
-    std::set<std::string> loadedEmails;
-    std::set<std::string> loadedPhoneNumbers;
+    const char* last = str.data() + str.size();
+    const auto [end, error] = std::from_chars(str.data() + pos, last, outValue);
+    return error == std::errc() && end == last;
+}
 
-    while (std::getline(file, line)) {
-        lineNum++;
+namespace {
+    constexpr size_t LOAD_BLOCK_SIZE = 1 << 22;
+    constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
 
-        if (line.empty()) {
-            continue;
-        }
+#ifdef _WIN32
+    constexpr std::string_view LINE_END = "\r\n";
+#else
+    constexpr std::string_view LINE_END = "\n";
+#endif
 
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> parts;
+    std::string_view withoutCarriageReturn(const std::string_view line) {
+        return !line.empty() && line.back() == '\r' ? line.substr(0, line.size() - 1) : line;
+    }
 
-        while (std::getline(ss, token, ';')) {
-            parts.push_back(token);
+    struct ParsedChunk {
+        std::vector<Contact> contacts;
+        std::vector<int> lineNums;
+        int lineCount = 0;
+
+        Contact failedContact;
+        int failedLineNum = 0;
+        std::string error;
+    };
+
+    void splitFields(const std::string_view line, const char delimiter, std::vector<std::string_view>& fields) {
+        fields.clear();
+        size_t pos = 0;
+        while (pos < line.size()) {
+            size_t end = line.find(delimiter, pos);
+            if (end == std::string_view::npos) {
+                end = line.size();
+            }
+            fields.push_back(line.substr(pos, end - pos));
+            pos = end + 1;
         }
+    }
+
+    std::string parseContactLine(const std::string_view line, Contact& contact, std::vector<std::string_view>& parts,
+                                 std::vector<std::string_view>& phonePairs) {
+        splitFields(line, ';', parts);
 
         if (parts.size() < 10) {
-            lastError = "Line " + std::to_string(lineNum) + ": not enough columns.";
-            return {};
+            return "not enough columns.";
         }
 
-        Contact contact;
-
         int id;
         if (!stringToInt(parts[0], id)) {
-            lastError = "Line " + std::to_string(lineNum) + ": ID is not a number.";
-            return {};
+            return "ID is not a number.";
         }
         if (id <= 0) {
-            lastError = "Line " + std::to_string(lineNum) + ": ID must be positive.";
-            return {};
-        }
-        if (loadedIds.count(id)) {
-            lastError = "Line " + std::to_string(lineNum) + ": duplicate ID found: " + std::to_string(id);
-            return {};
+            return "ID must be positive.";
         }
-        loadedIds.insert(id);
         contact.setId(id);
 
-        std::string surname = validation::trim(parts[1]);
+        const std::string_view surname = validation::trimView(parts[1]);
         if (!validation::isValidName(surname)) {
-            lastError = "Line " + std::to_string(lineNum) + ": invalid surname.";
-            return {};
+            return "invalid surname.";
         }
-        contact.setSurname(surname);
+        contact.setSurname(std::string(surname));
 
-        std::string forename = validation::trim(parts[2]);
+        const std::string_view forename = validation::trimView(parts[2]);
         if (!validation::isValidName(forename)) {
-            lastError = "Line " + std::to_string(lineNum) + ": invalid forename.";
-            return {};
+            return "invalid forename.";
         }
-        contact.setForename(forename);
+        contact.setForename(std::string(forename));
 
-        std::string patronymic = validation::trim(parts[3]);
+        const std::string_view patronymic = validation::trimView(parts[3]);
         if (!patronymic.empty() && !validation::isValidName(patronymic)) {
-            lastError = "Line " + std::to_string(lineNum) + ": invalid patronymic.";
-            return {};
+            return "invalid patronymic.";
         }
-        contact.setPatronymic(patronymic);
+        contact.setPatronymic(std::string(patronymic));
 
-        std::string address = validation::trim(parts[4]);
+        const std::string_view address = validation::trimView(parts[4]);
         if (!validation::isValidAddress(address)) {
-            lastError = "Line " + std::to_string(lineNum) + ": invalid address.";
-            return {};
+            return "invalid address.";
         }
-        contact.setAddress(address);
+        contact.setAddress(std::string(address));
 
         int day, month, year;
         bool dateOk = true;
@@ -104,109 +116,658 @@ std::vector<Contact> FileStorage::load() {
         dateOk &= stringToInt(parts[7], year);
 
         if (!dateOk) {
-            lastError = "Line " + std::to_string(lineNum) + ": birth date must be valid numbers.";
-            return {};
+            return "birth date must be valid numbers.";
         }
 
         if (!(day == 0 && month == 0 && year == 0)) {
             if (!validation::isValidDate(day, month, year)) {
-                lastError = "Line " + std::to_string(lineNum) + ": invalid birth date.";
-                return {};
+                return "invalid birth date.";
             }
         }
         contact.setBirthDate(Date(day, month, year));
 
-        std::string email = validation::trim(parts[8]);
+        const std::string email(validation::trimView(parts[8]));
         if (!validation::isValidEmail(email)) {
-            lastError = "Line " + std::to_string(lineNum) + ": invalid email.";
-            return {};
+            return "invalid email.";
+        }
+        if (!validation::isForenameInEmail(email, contact.getForename())) {
+            return "email does not contain forename.";
+        }
+        contact.setEmail(email);
+
+        splitFields(parts[9], '|', phonePairs);
+        for (const std::string_view phonePairStr : phonePairs) {
+            const size_t colonPos = phonePairStr.find(':');
+            if (colonPos == std::string_view::npos) {
+                return "malformed phone entry.";
+            }
+
+            const std::string_view type = validation::trimView(phonePairStr.substr(0, colonPos));
+            const std::string_view number = validation::trimView(phonePairStr.substr(colonPos + 1));
+
+            if (!validation::isValidPhoneType(type)) {
+                return "invalid phone type.";
+            }
+            if (!validation::isValidPhoneNumber(number)) {
+                return "invalid phone number.";
+            }
+            contact.addPhoneNumber(std::string(type), std::string(number));
+        }
+
+        if (contact.getPhoneNumbers().empty()) {
+            return "contact must have at least one phone number.";
+        }
+        return {};
+    }
+
+    void parseChunk(const std::string_view chunk, ParsedChunk& result) {
+        std::vector<std::string_view> parts;
+        std::vector<std::string_view> phonePairs;
+        size_t lineStart = 0;
+
+        while (lineStart < chunk.size()) {
+            size_t lineEnd = chunk.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos) {
+                lineEnd = chunk.size();
+            }
+            const std::string_view line = withoutCarriageReturn(chunk.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+            result.lineCount++;
+
+            if (line.empty()) {
+                continue;
+            }
+
+            Contact contact;
+            std::string error = parseContactLine(line, contact, parts, phonePairs);
+            if (!error.empty()) {
+                result.failedContact = std::move(contact);
+                result.failedLineNum = result.lineCount;
+                result.error = std::move(error);
+                return;
+            }
+
+            result.contacts.push_back(std::move(contact));
+            result.lineNums.push_back(result.lineCount);
+        }
+    }
+
+    std::vector<std::string_view> splitIntoBlocks(const std::string_view buffer) {
+        std::vector<std::string_view> blocks;
+        size_t blockStart = 0;
+        while (blockStart < buffer.size()) {
+            size_t blockEnd = buffer.size();
+            if (buffer.size() - blockStart > LOAD_BLOCK_SIZE) {
+                blockEnd = buffer.find('\n', blockStart + LOAD_BLOCK_SIZE);
+                blockEnd = blockEnd == std::string_view::npos ? buffer.size() : blockEnd + 1;
+            }
+            blocks.push_back(buffer.substr(blockStart, blockEnd - blockStart));
+            blockStart = blockEnd;
+        }
+        return blocks;
+    }
+
+    void appendContactLine(std::string& out, const Contact& contact) {
+        const Date birthDate = contact.getBirthDate();
+
+        out += std::to_string(contact.getId());
+        out += ';';
+        out += contact.getSurname();
+        out += ';';
+        out += contact.getForename();
+        out += ';';
+        out += contact.getPatronymic();
+        out += ';';
+        out += contact.getAddress();
+        out += ';';
+        out += std::to_string(birthDate.day);
+        out += ';';
+        out += std::to_string(birthDate.month);
+        out += ';';
+        out += std::to_string(birthDate.year);
+        out += ';';
+        out += contact.getEmail();
+        out += ';';
+
+        const std::vector<PhoneNumber>& phones = contact.getPhoneNumbers();
+        for (size_t i = 0; i < phones.size(); ++i) {
+            if (i > 0) {
+                out += '|';
+            }
+            out += phones[i].type;
+            out += ':';
+            out += phones[i].number;
         }
-        if (!validation::isForenameInEmail(email, forename)) {
-            lastError = "Line " + std::to_string(lineNum) + ": email does not contain forename.";
+        out += LINE_END;
+    }
+
+    class ContactFileWriter : public ContactVisitor {
+        std::FILE* file;
+        std::string buffer;
+        bool failed = false;
+
+        void flush() {
+            if (!failed && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+                failed = true;
+            }
+            buffer.clear();
+        }
+
+    public:
+        explicit ContactFileWriter(std::FILE* file) : file(file) {
+            buffer.reserve(WRITE_BUFFER_SIZE + 1024);
+        }
+
+        void visit(Contact&& contact) override {
+            write(contact);
+        }
+
+        void write(const Contact& contact) {
+            appendContactLine(buffer, contact);
+            if (buffer.size() >= WRITE_BUFFER_SIZE) {
+                flush();
+            }
+        }
+
+        bool finish() {
+            flush();
+            return !failed;
+        }
+    };
+
+    class DuplicateChecker {
+        std::unordered_set<int> loadedIds;
+        std::unordered_set<std::string> loadedEmails;
+        std::unordered_set<std::string> loadedPhoneNumbers;
+        std::vector<std::string_view> phoneSegments;
+
+    public:
+        explicit DuplicateChecker(const size_t expectedCount) {
+            loadedIds.reserve(expectedCount);
+            loadedEmails.reserve(expectedCount);
+            loadedPhoneNumbers.reserve(expectedCount);
+        }
+
+        std::string check(const Contact& contact) {
+            const int id = contact.getId();
+            if (id != 0 && !loadedIds.insert(id).second) {
+                return "duplicate ID found: " + std::to_string(id);
+            }
+
+            const ContactSearchKeys& keys = contact.getSearchKeys();
+            if (!keys.email.empty() && !loadedEmails.insert(keys.email).second) {
+                return "duplicate email found.";
+            }
+
+            splitFields(keys.phoneDigits, '|', phoneSegments);
+            for (const std::string_view digits : phoneSegments) {
+                if (!loadedPhoneNumbers.emplace(digits).second) {
+                    return "duplicate phone number found.";
+                }
+            }
             return {};
         }
+    };
+}
 
-        std::string normalizedEmail = validation::normalizeEmail(email);
-        if (loadedEmails.count(normalizedEmail)) {
-            lastError = "Line " + std::to_string(lineNum) + ": duplicate email found.";
+class FileStorage::JournalOverlay {
+    struct Entry {
+        std::optional<Contact> latest;
+        bool deleted = false;
+        bool inBase = false;
+        uint64_t appendSeq = 0;
+    };
+
+    std::unordered_map<int, Entry> entries;
+    uint64_t nextSeq = 0;
+
+public:
+    std::string apply(const std::string_view record, std::vector<std::string_view>& parts,
+                      std::vector<std::string_view>& phonePairs) {
+        if (record.size() < 2 || record[1] != ';') {
+            return "unknown journal record.";
+        }
+        const std::string_view payload = record.substr(2);
+
+        if (record[0] == '-') {
+            int id;
+            if (!stringToInt(payload, id)) {
+                return "ID is not a number.";
+            }
+
+            Entry& entry = entries[id];
+            entry.latest.reset();
+            entry.deleted = true;
             return {};
         }
-        loadedEmails.insert(normalizedEmail);
-        contact.setEmail(normalizedEmail);
 
-        std::stringstream phonesStream(parts[9]);
-        std::string phonePairStr;
-        while (std::getline(phonesStream, phonePairStr, '|')) {
-            size_t colonPos = phonePairStr.find(':');
-            if (colonPos != std::string::npos) {
-                std::string type = validation::trim(phonePairStr.substr(0, colonPos));
-                std::string number = validation::trim(phonePairStr.substr(colonPos + 1));
+        if (record[0] != '+') {
+            return "unknown journal record.";
+        }
 
-                if (!validation::isValidPhoneType(type)) {
-                    lastError = "Line " + std::to_string(lineNum) + ": invalid phone type.";
-                    return {};
-                }
-                if (!validation::isValidPhoneNumber(number)) {
-                    lastError = "Line " + std::to_string(lineNum) + ": invalid phone number.";
-                    return {};
+        Contact contact;
+        std::string error = parseContactLine(payload, contact, parts, phonePairs);
+        if (!error.empty()) {
+            return error;
+        }
+
+        Entry& entry = entries[contact.getId()];
+        if (!entry.latest) {
+            entry.appendSeq = nextSeq++;
+        }
+        entry.latest = std::move(contact);
+        return {};
+    }
+
+    bool applyToBase(Contact& contact) {
+        const auto it = entries.find(contact.getId());
+        if (it == entries.end()) {
+            return true;
+        }
+
+        Entry& entry = it->second;
+        entry.inBase = true;
+        if (entry.deleted) {
+            return false;
+        }
+        contact = std::move(*entry.latest);
+        return true;
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    void visitAppended(ContactVisitor& visitor) {
+        std::vector<Entry*> appended;
+        for (auto& [id, entry] : entries) {
+            if (entry.latest && (entry.deleted || !entry.inBase)) {
+                appended.push_back(&entry);
+            }
+        }
+        std::sort(appended.begin(), appended.end(),
+                  [](const Entry* a, const Entry* b) { return a->appendSeq < b->appendSeq; });
+
+        for (Entry* entry : appended) {
+            visitor.visit(std::move(*entry->latest));
+        }
+    }
+};
+
+bool FileStorage::loadInto(ContactVisitor& visitor) {
+    waitForCompaction();
+    lastError.clear();
+
+    if (!recoverPendingBase()) {
+        return false;
+    }
+    return loadMerged(true, visitor);
+}
+
+bool FileStorage::loadMerged(const bool includeJournal, ContactVisitor& visitor) {
+    MappedFile journal;
+    MappedFile compacting;
+    MappedFile file;
+
+    if ((includeJournal && !openJournal(journalFilename(), journal)) ||
+        !openJournal(compactingFilename(), compacting)) {
+        return false;
+    }
+
+    if (!file.open(filename)) {
+        lastError = "Cannot open file '" + filename + "' for reading.";
+        return false;
+    }
+
+    JournalOverlay overlay;
+    if (!replayJournal(compactingFilename(), compacting, overlay) ||
+        (includeJournal && !replayJournal(journalFilename(), journal, overlay))) {
+        return false;
+    }
+
+    const std::string_view buffer = file.view();
+    const auto lineCount = static_cast<size_t>(std::count(buffer.begin(), buffer.end(), '\n')) + 1;
+    visitor.reserve(lineCount + overlay.size());
+
+    const std::vector<std::string_view> blocks = splitIntoBlocks(buffer);
+    const size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    DuplicateChecker duplicates(lineCount);
+    int lineOffset = 0;
+
+    for (size_t waveStart = 0; waveStart < blocks.size(); waveStart += threadCount) {
+        const size_t waveSize = std::min(threadCount, blocks.size() - waveStart);
+        std::vector<ParsedChunk> parsedChunks(waveSize);
+
+        if (waveSize == 1) {
+            parseChunk(blocks[waveStart], parsedChunks.front());
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(waveSize);
+            for (size_t i = 0; i < waveSize; ++i) {
+                workers.emplace_back(parseChunk, blocks[waveStart + i], std::ref(parsedChunks[i]));
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        for (ParsedChunk& chunk : parsedChunks) {
+            for (size_t i = 0; i < chunk.contacts.size(); ++i) {
+                const std::string error = duplicates.check(chunk.contacts[i]);
+                if (!error.empty()) {
+                    lastError = "Line " + std::to_string(lineOffset + chunk.lineNums[i]) + ": " + error;
+                    return false;
                 }
 
-                std::string normalizedNumber = validation::normalizePhoneNumber(number);
-                if (loadedPhoneNumbers.count(normalizedNumber)) {
-                    lastError = "Line " + std::to_string(lineNum) + ": duplicate phone number found.";
-                    return {};
+                if (overlay.applyToBase(chunk.contacts[i])) {
+                    visitor.visit(std::move(chunk.contacts[i]));
                 }
-                loadedPhoneNumbers.insert(normalizedNumber);
+            }
 
-                contact.addPhoneNumber(type, normalizedNumber);
-            } else {
-                 lastError = "Line " + std::to_string(lineNum) + ": malformed phone entry.";
-                 return {};
+            if (!chunk.error.empty()) {
+                std::string error = duplicates.check(chunk.failedContact);
+                if (error.empty()) {
+                    error = chunk.error;
+                }
+                lastError = "Line " + std::to_string(lineOffset + chunk.failedLineNum) + ": " + error;
+                return false;
             }
+            lineOffset += chunk.lineCount;
         }
+    }
 
-        if (contact.getPhoneNumbers().empty()) {
-            lastError = "Line " + std::to_string(lineNum) + ": contact must have at least one phone number.";
-            return {};
+    overlay.visitAppended(visitor);
+    return true;
+}
+
+FileStorage::~FileStorage() {
+    waitForCompaction();
+}
+
+bool FileStorage::isJournalEnabled() const {
+    return journalEnabled;
+}
+
+void FileStorage::setJournalEnabled(const bool enabled) {
+    journalEnabled = enabled;
+}
+
+size_t FileStorage::getJournalCompactionThreshold() const {
+    return journalCompactionThreshold;
+}
+
+void FileStorage::setJournalCompactionThreshold(const size_t threshold) {
+    journalCompactionThreshold = threshold;
+}
+
+bool FileStorage::saveFrom(const ContactProducer& producer) {
+    waitForCompaction();
+    lastError.clear();
+
+    const std::string tempPath = filename + ".tmp";
+    const bool written = fileio::writeFileSynced(tempPath, [&producer](std::FILE* file) {
+        ContactFileWriter writer(file);
+        while (const Contact* contact = producer()) {
+            writer.write(*contact);
         }
+        return writer.finish();
+    }, lastError);
+
+    return written && commitBase(tempPath, pendingFilename(), true);
+}
+
+bool FileStorage::saveChanges(const std::vector<Contact>& contacts, const ContactChanges& changes) {
+    if (!journalEnabled || changes.fullRewrite || changes.orderChanged) {
+        return save(contacts);
+    }
 
-        contacts.push_back(contact);
+    lastError.clear();
+    if (changes.upserted.empty() && changes.deletedIds.empty()) {
+        return true;
     }
 
+    size_t journalSize = 0;
+    if (!appendJournal(changes, journalSize)) {
+        return false;
+    }
+
+    bool compacted = !compactionFinished || waitForCompaction();
+    if (compacted && journalSize >= journalCompactionThreshold) {
+        compacted = startCompaction();
+    }
+    if (!compacted) {
+        lastError = "Changes were saved to the journal, but compaction failed: " + lastError;
+        return false;
+    }
+    return true;
+}
+
+std::string FileStorage::journalFilename() const {
+    return filename + ".journal";
+}
+
+std::string FileStorage::compactingFilename() const {
+    return filename + ".journal.compacting";
+}
+
+std::string FileStorage::pendingFilename() const {
+    return filename + ".pending";
+}
+
+std::string FileStorage::compactedFilename() const {
+    return filename + ".compacted";
+}
+
+bool FileStorage::removeFile(const std::string& path) {
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    if (error) {
+        lastError = "Cannot remove file '" + path + "': " + error.message();
+        return false;
+    }
+    return true;
+}
+
+bool FileStorage::commitBase(const std::string& tempPath, const std::string& committedPath, const bool dropJournal) {
+    if (!fileio::replaceFile(tempPath, committedPath, lastError)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return finishCommit(committedPath, dropJournal);
+}
+
+bool FileStorage::finishCommit(const std::string& committedPath, const bool dropJournal) {
+    if (!removeFile(compactingFilename()) || (dropJournal && !removeFile(journalFilename()))) {
+        return false;
+    }
+    fileio::syncParentDirectory(filename);
+    return fileio::replaceFile(committedPath, filename, lastError);
+}
+
+bool FileStorage::recoverPendingBase() {
+    std::error_code error;
+    if (std::filesystem::exists(compactedFilename(), error) && !finishCommit(compactedFilename(), false)) {
+        return false;
+    }
+    if (std::filesystem::exists(pendingFilename(), error) && !finishCommit(pendingFilename(), true)) {
+        return false;
+    }
+    return true;
+}
+
+bool FileStorage::openJournal(const std::string& path, MappedFile& file) {
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) {
+        return true;
+    }
+
+    if (!file.open(path)) {
+        lastError = "Cannot open file '" + path + "' for reading.";
+        return false;
+    }
+    return true;
+}
+
+bool FileStorage::replayJournal(const std::string& path, MappedFile& file, JournalOverlay& overlay) {
+    const std::string_view buffer = file.view();
+    std::vector<std::string_view> parts;
+    std::vector<std::string_view> phonePairs;
+    size_t recordStart = 0;
+    int lineNum = 0;
+
+    while (recordStart < buffer.size()) {
+        const size_t recordEnd = buffer.find('\n', recordStart);
+        if (recordEnd == std::string_view::npos) {
+            break;
+        }
+        const std::string_view record = withoutCarriageReturn(buffer.substr(recordStart, recordEnd - recordStart));
+        recordStart = recordEnd + 1;
+        lineNum++;
+
+        if (record.empty()) {
+            continue;
+        }
+
+        const std::string recordError = overlay.apply(record, parts, phonePairs);
+        if (!recordError.empty()) {
+            lastError = "File '" + path + "', line " + std::to_string(lineNum) + ": " + recordError;
+            return false;
+        }
+    }
+
+    const size_t validSize = recordStart;
+    const bool tornTail = validSize < buffer.size();
     file.close();
-    return contacts;
+
+    if (tornTail) {
+        std::error_code error;
+        std::filesystem::resize_file(path, validSize, error);
+    }
+    return true;
 }
 
-bool FileStorage::save(const std::vector<Contact>& contacts) {
-    std::ofstream file(filename);
+bool FileStorage::appendJournal(const ContactChanges& changes, size_t& journalSize) {
+    const std::string journal = journalFilename();
+    std::error_code error;
+    const bool created = !std::filesystem::exists(journal, error);
 
-    if (!file.is_open()) {
+    std::string records;
+    for (const int id : changes.deletedIds) {
+        records += "-;";
+        records += std::to_string(id);
+        records += LINE_END;
+    }
+    for (const Contact& contact : changes.upserted) {
+        records += "+;";
+        appendContactLine(records, contact);
+    }
+
+    std::FILE* file = std::fopen(journal.c_str(), "ab");
+    if (file == nullptr) {
+        lastError = "Cannot open file '" + journal + "' for writing.";
         return false;
     }
 
-    for (const Contact& contact : contacts) {
-        file << contact.getId() << ";"
-            << contact.getSurname() << ";"
-            << contact.getForename() << ";"
-            << contact.getPatronymic() << ";"
-            << contact.getAddress() << ";"
-            << contact.getBirthDate().day << ";"
-            << contact.getBirthDate().month << ";"
-            << contact.getBirthDate().year << ";"
-            << contact.getEmail() << ";";
+    bool written = std::fwrite(records.data(), 1, records.size(), file) == records.size();
+    written = written && std::fflush(file) == 0 && fileio::syncFile(file);
 
-        std::stringstream phonesStream;
-        const std::vector<PhoneNumber>& phones = contact.getPhoneNumbers();
-        for (size_t i = 0; i < phones.size(); ++i) {
-            phonesStream << phones[i].type << ":" << phones[i].number;
-            if (i < phones.size() - 1) {
-                phonesStream << "|";
+    const long position = std::ftell(file);
+    journalSize = position < 0 ? 0 : static_cast<size_t>(position);
+    written = std::fclose(file) == 0 && written;
+
+    if (!written) {
+        lastError = "Cannot write file '" + journal + "'.";
+        return false;
+    }
+
+    if (created) {
+        fileio::syncParentDirectory(journal);
+    }
+    return true;
+}
+
+bool FileStorage::startCompaction() {
+    if (!waitForCompaction()) {
+        return false;
+    }
+
+    const std::string journal = journalFilename();
+    const std::string compacting = compactingFilename();
+    std::error_code error;
+
+    if (std::filesystem::exists(compacting, error)) {
+        std::string records;
+        {
+            MappedFile file;
+            if (!file.open(journal)) {
+                lastError = "Cannot open file '" + journal + "' for reading.";
+                return false;
             }
+            records = file.view();
         }
 
-        file << phonesStream.str() << std::endl;
+        std::FILE* file = std::fopen(compacting.c_str(), "ab");
+        if (file == nullptr) {
+            lastError = "Cannot open file '" + compacting + "' for writing.";
+            return false;
+        }
+        bool written = std::fwrite(records.data(), 1, records.size(), file) == records.size();
+        written = written && std::fflush(file) == 0 && fileio::syncFile(file);
+        written = std::fclose(file) == 0 && written;
+
+        if (!written) {
+            lastError = "Cannot write file '" + compacting + "'.";
+            return false;
+        }
+        if (!removeFile(journal)) {
+            return false;
+        }
+    } else if (!fileio::replaceFile(journal, compacting, lastError)) {
+        return false;
     }
+    fileio::syncParentDirectory(compacting);
 
-    file.close();
+    compactionFinished = false;
+    compactionThread = std::thread([this]() {
+        FileStorage compactor(filename);
+        if (!compactor.writeCompactedBase()) {
+            compactionError = compactor.lastError;
+        }
+        compactionFinished = true;
+    });
     return true;
 }
+
+bool FileStorage::writeCompactedBase() {
+    const std::string tempPath = filename + ".tmp";
+    std::string loadError;
+    const bool written = fileio::writeFileSynced(tempPath, [this, &loadError](std::FILE* file) {
+        ContactFileWriter writer(file);
+        if (!loadMerged(false, writer)) {
+            loadError = lastError;
+            return false;
+        }
+        return writer.finish();
+    }, lastError);
+
+    if (!written) {
+        if (!loadError.empty()) {
+            lastError = loadError;
+        }
+        return false;
+    }
+    return commitBase(tempPath, compactedFilename(), false);
+}
+
+bool FileStorage::waitForCompaction() {
+    if (compactionThread.joinable()) {
+        compactionThread.join();
+    }
+    if (compactionError.empty()) {
+        return true;
+    }
+
+    lastError = compactionError;
+    compactionError.clear();
+    return false;
+}
@@ -1,14 +1,51 @@
 #pragma once
 #include "ContactStorage.h"
+#include "MappedFile.h"
 #include "iostream"
+#include <atomic>
 #include <string>
+#include <thread>
 #include <utility>
 
 class FileStorage : public ContactStorage {
+    class JournalOverlay;
+
     std::string filename;
+    bool journalEnabled = false;
+    size_t journalCompactionThreshold = 4 << 20;
+    std::thread compactionThread;
+    std::atomic<bool> compactionFinished{false};
+    std::string compactionError;
+
+    std::string journalFilename() const;
+    std::string compactingFilename() const;
+    std::string pendingFilename() const;
+    std::string compactedFilename() const;
+
+    bool removeFile(const std::string& path);
+    bool commitBase(const std::string& tempPath, const std::string& committedPath, bool dropJournal);
+    bool finishCommit(const std::string& committedPath, bool dropJournal);
+    bool recoverPendingBase();
+
+    bool loadMerged(bool includeJournal, ContactVisitor& visitor);
+    bool openJournal(const std::string& path, MappedFile& file);
+    bool replayJournal(const std::string& path, MappedFile& file, JournalOverlay& overlay);
+    bool appendJournal(const ContactChanges& changes, size_t& journalSize);
+    bool startCompaction();
+    bool writeCompactedBase();
+    bool waitForCompaction();
+
 public:
     explicit FileStorage(std::string filename) : filename(std::move(filename)) {}
+    ~FileStorage() override;
+
+    bool isJournalEnabled() const;
+    void setJournalEnabled(bool enabled);
+
+    size_t getJournalCompactionThreshold() const;
+    void setJournalCompactionThreshold(size_t threshold);
 
-    std::vector<Contact> load() override;
-    bool save(const std::vector<Contact>& contacts) override;
+    bool loadInto(ContactVisitor& visitor) override;
+    bool saveFrom(const ContactProducer& producer) override;
+    bool saveChanges(const std::vector<Contact>& contacts, const ContactChanges& changes) override;
 };
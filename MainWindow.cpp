@@ -3,14 +3,28 @@
 #include "FileStorage.h"
 #include "SearchDialog.h"
 #include "SortDialog.h"
+#include "sorting.h"
+#include "validation.h"
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QMessageBox>
+#include <QScrollBar>
+#include <algorithm>
+#include <iterator>
 
-MainWindow::MainWindow(Phonebook& phonebook, ContactStorage* storage, QWidget *parent)
-    : QMainWindow(parent), phonebook(phonebook), storage(storage) {
+namespace {
+    const SortField COLUMN_SORT_FIELDS[] = {SortField::ID, SortField::SURNAME, SortField::FORENAME,
+        SortField::PATRONYMIC, SortField::ADDRESS, SortField::BIRTH_DATE, SortField::EMAIL};
+}
+
+MainWindow::MainWindow(Phonebook& phonebook, ContactStorage* storage, ContactPager* pager, QWidget *parent)
+    : QMainWindow(parent), phonebook(phonebook), storage(storage), pager(pager) {
     setupUi();
-    refreshTable(phonebook.getAllContacts());
+    showAllContacts();
+
+    if (pager != nullptr && phonebook.getAllContacts().empty()) {
+        loadNextPage();
+    }
 }
 
 void MainWindow::setupUi() {
@@ -45,7 +59,9 @@ void MainWindow::setupUi() {
     tableWidget->setColumnCount(headers.size());
     tableWidget->setHorizontalHeaderLabels(headers);
 
-    tableWidget->setSortingEnabled(true);
+    tableWidget->horizontalHeader()->setSectionsClickable(true);
+    tableWidget->horizontalHeader()->setSortIndicatorShown(true);
+    tableWidget->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
 
     tableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
     tableWidget->horizontalHeader()->setSectionResizeMode(4, QHeaderView::Stretch);
@@ -76,62 +92,159 @@ void MainWindow::setupUi() {
     connect(btnAdvancedSearch, &QPushButton::clicked, this, &MainWindow::onAdvancedSearchClicked);
     connect(btnAdvancedSort, &QPushButton::clicked, this, &MainWindow::onAdvancedSortClicked);
     connect(btnReset, &QPushButton::clicked, this, &MainWindow::onResetClicked);
+    connect(tableWidget->verticalScrollBar(), &QScrollBar::valueChanged, this, &MainWindow::onTableScrolled);
+    connect(tableWidget->horizontalHeader(), &QHeaderView::sortIndicatorChanged, this,
+            &MainWindow::onSortIndicatorChanged);
 }
 
-void MainWindow::refreshTable(const std::vector<Contact>& contactsToShow) const {
-    const bool wasSortingEnabled = tableWidget->isSortingEnabled();
-    tableWidget->setSortingEnabled(false);
-    tableWidget->setRowCount(0);
+void MainWindow::showAllContacts() {
+    showingAllContacts = true;
+    displayedResults.clear();
 
-    for (const auto& contact : contactsToShow) {
-        const int row = tableWidget->rowCount();
-        tableWidget->insertRow(row);
+    tableWidget->setRowCount(0);
+    for (const int id : phonebook.sortedIds(displayCriteria)) {
+        appendTableRow(*phonebook.findContact(id));
+    }
+}
 
-        QTableWidgetItem* idItem = new QTableWidgetItem();
-        idItem->setData(Qt::DisplayRole, contact.getId());
-        tableWidget->setItem(row, 0, idItem);
+void MainWindow::showResults(std::vector<Contact> results) {
+    showingAllContacts = false;
+    displayedResults = std::move(results);
+    if (!displayCriteria.empty()) {
+        sorting::applyPermutation(displayedResults, sorting::sortedPermutation(displayedResults, displayCriteria));
+    }
 
-        tableWidget->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(contact.getSurname())));
-        tableWidget->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(contact.getForename())));
-        tableWidget->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(contact.getPatronymic())));
-        tableWidget->setItem(row, 4, new QTableWidgetItem(QString::fromStdString(contact.getAddress())));
+    tableWidget->setRowCount(0);
+    appendTableRows(displayedResults);
+}
 
-        const Date birthDate = contact.getBirthDate();
-        QString dateStr;
+void MainWindow::redisplay() {
+    if (showingAllContacts) {
+        showAllContacts();
+    } else {
+        showResults(std::move(displayedResults));
+    }
+}
 
-        if (birthDate.day != 0) {
-            dateStr = QString("%1.%2.%3")
-                        .arg(birthDate.year, 4, 10, QChar('0'))
-                        .arg(birthDate.month, 2, 10, QChar('0'))
-                        .arg(birthDate.day, 2, 10, QChar('0'));
+void MainWindow::updateSortIndicator() const {
+    int column = -1;
+    Qt::SortOrder order = Qt::AscendingOrder;
+    if (displayCriteria.size() == 1) {
+        const auto it = std::find(std::begin(COLUMN_SORT_FIELDS), std::end(COLUMN_SORT_FIELDS),
+                                  displayCriteria.front().field);
+        column = static_cast<int>(it - std::begin(COLUMN_SORT_FIELDS));
+        if (displayCriteria.front().direction == SortDirection::DESCENDING) {
+            order = Qt::DescendingOrder;
         }
+    }
 
-        tableWidget->setItem(row, 5, new QTableWidgetItem(dateStr));
+    QHeaderView* header = tableWidget->horizontalHeader();
+    header->blockSignals(true);
+    header->setSortIndicator(column, order);
+    header->blockSignals(false);
+}
 
-        tableWidget->setItem(row, 6, new QTableWidgetItem(QString::fromStdString(contact.getEmail())));
+void MainWindow::appendTableRows(const std::vector<Contact>& contactsToAppend) const {
+    for (const auto& contact : contactsToAppend) {
+        appendTableRow(contact);
+    }
+}
 
-        QString phonesStr;
-        const auto& numbers = contact.getPhoneNumbers();
-        for (size_t i = 0; i < numbers.size(); ++i) {
-            phonesStr += QString::fromStdString(numbers[i].type) + ": " +
-                         QString::fromStdString(numbers[i].number);
-            if (i < numbers.size() - 1) {
-                phonesStr += ", ";
-            }
+void MainWindow::appendTableRow(const Contact& contact) const {
+    const int row = tableWidget->rowCount();
+    tableWidget->insertRow(row);
+
+    QTableWidgetItem* idItem = new QTableWidgetItem();
+    idItem->setData(Qt::DisplayRole, contact.getId());
+    tableWidget->setItem(row, 0, idItem);
+
+    tableWidget->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(contact.getSurname())));
+    tableWidget->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(contact.getForename())));
+    tableWidget->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(contact.getPatronymic())));
+    tableWidget->setItem(row, 4, new QTableWidgetItem(QString::fromStdString(contact.getAddress())));
+
+    const Date birthDate = contact.getBirthDate();
+    QString dateStr;
+
+    if (birthDate.day != 0) {
+        dateStr = QString("%1.%2.%3")
+                    .arg(birthDate.year, 4, 10, QChar('0'))
+                    .arg(birthDate.month, 2, 10, QChar('0'))
+                    .arg(birthDate.day, 2, 10, QChar('0'));
+    }
+
+    tableWidget->setItem(row, 5, new QTableWidgetItem(dateStr));
+
+    tableWidget->setItem(row, 6, new QTableWidgetItem(QString::fromStdString(contact.getEmail())));
+
+    QString phonesStr;
+    const auto& numbers = contact.getPhoneNumbers();
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        phonesStr += QString::fromStdString(numbers[i].type) + ": " +
+                     QString::fromStdString(numbers[i].number);
+        if (i < numbers.size() - 1) {
+            phonesStr += ", ";
         }
-        tableWidget->setItem(row, 7, new QTableWidgetItem(phonesStr));
+    }
+    tableWidget->setItem(row, 7, new QTableWidgetItem(phonesStr));
+}
+
+void MainWindow::loadNextPage() {
+    std::vector<Contact> page;
+    if (!pager->fetchNextPage(page)) {
+        QMessageBox::critical(this, "Storage error", QString::fromStdString(pager->getLastError()));
+        return;
+    }
+
+    if (canAppendPage(page)) {
+        appendTableRows(page);
+    } else {
+        showAllContacts();
+    }
+}
+
+bool MainWindow::canAppendPage(const std::vector<Contact>& page) const {
+    if (displayCriteria.empty() || page.empty()) {
+        return true;
+    }
+    if (displayCriteria.size() != 1 || displayCriteria.front().field != SortField::ID ||
+        displayCriteria.front().direction != SortDirection::ASCENDING) {
+        return false;
+    }
+
+    const int lastRow = tableWidget->rowCount() - 1;
+    return lastRow < 0 || tableWidget->item(lastRow, 0)->data(Qt::DisplayRole).toInt() < page.front().getId();
+}
+
+void MainWindow::onTableScrolled(const int value) {
+    if (pager == nullptr || pager->isExhausted() || !showingAllContacts) {
+        return;
     }
 
-    tableWidget->setSortingEnabled(wasSortingEnabled);
+    const QScrollBar* scrollBar = tableWidget->verticalScrollBar();
+    if (value >= scrollBar->maximum() - scrollBar->pageStep()) {
+        loadNextPage();
+    }
+}
+
+void MainWindow::onSortIndicatorChanged(const int column, const Qt::SortOrder order) {
+    if (column < 0 || column >= static_cast<int>(std::size(COLUMN_SORT_FIELDS))) {
+        updateSortIndicator();
+        return;
+    }
+
+    displayCriteria = {{COLUMN_SORT_FIELDS[column],
+                        order == Qt::AscendingOrder ? SortDirection::ASCENDING : SortDirection::DESCENDING}};
+    redisplay();
 }
 
 void MainWindow::onAddClicked() {
-    ContactDialog dialog(phonebook, nullptr, this);
+    ContactDialog dialog(phonebook, pager, nullptr, this);
 
     if (dialog.exec() == QDialog::Accepted) {
         Contact newContact = dialog.getContact();
         phonebook.addContact(newContact);
-        refreshTable(phonebook.getAllContacts());
+        showAllContacts();
     }
 }
 
@@ -145,27 +258,16 @@ void MainWindow::onEditClicked() {
     const int row = selectedItems[0]->row();
     const int id = tableWidget->item(row, 0)->text().toInt();
 
-    Contact* contactPtr = phonebook.findContact(id);
+    const Contact* contactPtr = phonebook.findContact(id);
 
-    ContactDialog dialog(phonebook, contactPtr, this);
+    ContactDialog dialog(phonebook, pager, contactPtr, this);
 
     if (dialog.exec() == QDialog::Accepted) {
-        const Contact updatedContact = dialog.getContact();
-
-        contactPtr->setSurname(updatedContact.getSurname());
-        contactPtr->setForename(updatedContact.getForename());
-        contactPtr->setPatronymic(updatedContact.getPatronymic());
-        contactPtr->setAddress(updatedContact.getAddress());
-        contactPtr->setBirthDate(updatedContact.getBirthDate());
-        contactPtr->setEmail(updatedContact.getEmail());
-
-        contactPtr->clearPhoneNumbers();
+        Contact updatedContact = dialog.getContact();
+        updatedContact.setId(id);
+        phonebook.updateContact(updatedContact);
 
-        for (const auto& phone : updatedContact.getPhoneNumbers()) {
-            contactPtr->addPhoneNumber(phone.type, phone.number);
-        }
-
-        refreshTable(phonebook.getAllContacts());
+        showAllContacts();
     }
 }
 
@@ -185,12 +287,27 @@ void MainWindow::onDeleteClicked() {
 
     if (reply == QMessageBox::Yes) {
         phonebook.deleteContact(id);
-        refreshTable(phonebook.getAllContacts());
+        showAllContacts();
     }
 }
 
-void MainWindow::onSearchChanged(const QString &text) const {
-    refreshTable(phonebook.searchAllFields(text.toStdString()));
+void MainWindow::onSearchChanged(const QString &text) {
+    const std::string query = text.toStdString();
+    if (validation::trim(query).empty()) {
+        showAllContacts();
+        return;
+    }
+    if (pager == nullptr) {
+        showResults(phonebook.searchAllFields(query));
+        return;
+    }
+
+    std::vector<Contact> results;
+    if (!pager->searchAllFields(query, results)) {
+        QMessageBox::critical(this, "Storage error", QString::fromStdString(pager->getLastError()));
+        return;
+    }
+    showResults(std::move(results));
 }
 
 void MainWindow::onAdvancedSortClicked() {
@@ -202,10 +319,9 @@ void MainWindow::onAdvancedSortClicked() {
             return;
         }
 
-        phonebook.sortContacts(criteria);
-        tableWidget->setSortingEnabled(false);
-
-        refreshTable(phonebook.getAllContacts());
+        displayCriteria = criteria;
+        updateSortIndicator();
+        redisplay();
     }
 }
 
@@ -213,25 +329,30 @@ void MainWindow::onAdvancedSearchClicked() {
     SearchDialog dialog(this);
     if (dialog.exec() == QDialog::Accepted) {
         const auto criteria = dialog.getCriteria();
-        const std::vector<Contact> results = phonebook.searchContacts(criteria);
+        std::vector<Contact> results;
+        if (pager != nullptr) {
+            if (!pager->search(criteria, results)) {
+                QMessageBox::critical(this, "Storage error", QString::fromStdString(pager->getLastError()));
+                return;
+            }
+        } else {
+            results = phonebook.searchContacts(criteria);
+        }
+        searchBar->blockSignals(true);
         searchBar->clear();
-        refreshTable(results);
+        searchBar->blockSignals(false);
+        showResults(std::move(results));
     }
 }
 
-void MainWindow::onResetClicked() const {
+void MainWindow::onResetClicked() {
+    searchBar->blockSignals(true);
     searchBar->clear();
+    searchBar->blockSignals(false);
 
-    tableWidget->setSortingEnabled(false);
-    tableWidget->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
-
-    std::vector<SortCriterion> defaultCriteria;
-    defaultCriteria.push_back({SortField::ID, SortDirection::ASCENDING});
-    phonebook.sortContacts(defaultCriteria);
-
-    refreshTable(phonebook.getAllContacts());
-
-    tableWidget->setSortingEnabled(true);
+    displayCriteria = {{SortField::ID, SortDirection::ASCENDING}};
+    updateSortIndicator();
+    showAllContacts();
 }
 
 void MainWindow::closeEvent(QCloseEvent *event) {
@@ -244,26 +365,12 @@ void MainWindow::closeEvent(QCloseEvent *event) {
     }
 
     if (reply == QMessageBox::Yes) {
-        const bool isFiltered = tableWidget->rowCount() != static_cast<int>(phonebook.getAllContacts().size());
-
-        if (isFiltered) {
-            if (!searchBar->text().isEmpty()) {
-                searchBar->blockSignals(true);
-                searchBar->clear();
-                searchBar->blockSignals(false);
-            }
-
-            refreshTable(phonebook.getAllContacts());
-        }
-
-        std::vector<int> orderedIds;
-        for (int row = 0; row < tableWidget->rowCount(); ++row) {
-            int id = tableWidget->item(row, 0)->text().toInt();
-            orderedIds.push_back(id);
+        if (!displayCriteria.empty()) {
+            phonebook.sortContacts(displayCriteria);
         }
-        phonebook.reorderContacts(orderedIds);
 
-        if (storage->save(phonebook.getAllContacts())) {
+        if (storage->saveChanges(phonebook.getAllContacts(), phonebook.getChanges())) {
+            phonebook.markSaved();
             event->accept();
         } else {
             const QString msg = "Failed to save contacts.\n" +  QString::fromStdString(storage->getLastError());
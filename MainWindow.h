@@ -1,4 +1,5 @@
 #pragma once
+#include "ContactPager.h"
 #include "ContactStorage.h"
 #include "Phonebook.h"
 #include <QMainWindow>
@@ -13,7 +14,8 @@ class MainWindow : public QMainWindow {
     Q_OBJECT
 
 public:
-    explicit MainWindow(Phonebook& phonebook, ContactStorage* storage, QWidget *parent = nullptr);
+    explicit MainWindow(Phonebook& phonebook, ContactStorage* storage, ContactPager* pager = nullptr,
+                        QWidget *parent = nullptr);
     ~MainWindow() override = default;
 
 protected:
@@ -24,14 +26,20 @@ private slots:
     void onEditClicked();
     void onDeleteClicked();
 
-    void onSearchChanged(const QString &text) const;
+    void onSearchChanged(const QString &text);
     void onAdvancedSearchClicked();
     void onAdvancedSortClicked();
-    void onResetClicked() const;
+    void onResetClicked();
+    void onTableScrolled(int value);
+    void onSortIndicatorChanged(int column, Qt::SortOrder order);
 
 private:
     Phonebook& phonebook;
     ContactStorage* storage;
+    ContactPager* pager;
+    bool showingAllContacts = true;
+    std::vector<SortCriterion> displayCriteria;
+    std::vector<Contact> displayedResults;
 
     QWidget* centralWidget;
     QTableWidget* tableWidget;
@@ -43,7 +51,14 @@ private:
     QPushButton* btnAdvancedSearch;
     QPushButton* btnReset;
 
-    void refreshTable(const std::vector<Contact>& contactsToShow) const;
+    void showAllContacts();
+    void showResults(std::vector<Contact> results);
+    void redisplay();
+    void updateSortIndicator() const;
+    void appendTableRows(const std::vector<Contact>& contactsToAppend) const;
+    void appendTableRow(const Contact& contact) const;
+    bool canAppendPage(const std::vector<Contact>& page) const;
+    void loadNextPage();
 
     void setupUi();
 };
@@ -0,0 +1,22 @@
+#pragma once
+#include "Contact.h"
+#include "Phonebook.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class PagedContactSource {
+public:
+    virtual ~PagedContactSource() = default;
+
+    virtual bool fetchPage(int afterId, int limit, std::vector<Contact>& page) = 0;
+    virtual bool fetchMaxId(int& maxId) = 0;
+    virtual bool searchContacts(const std::map<SearchField, std::string>& criteria, int limit,
+                                std::vector<Contact>& results) = 0;
+    virtual bool searchAllFields(const std::string& query, int limit, std::vector<int>& ids) = 0;
+    virtual bool fetchContacts(const std::vector<int>& ids, std::vector<Contact>& contacts) = 0;
+    virtual bool findEmailOwners(const std::string& email, std::vector<int>& ids) = 0;
+    virtual bool findPhoneOwners(const std::string& number, std::vector<int>& ids) = 0;
+
+    virtual std::string getLastError() const = 0;
+};
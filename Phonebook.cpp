@@ -1,59 +1,73 @@
 #include "Phonebook.h"
+#include "sorting.h"
 #include "validation.h"
 #include <algorithm>
 #include <cctype>
 #include <iostream>
 
-Phonebook::Phonebook() : nextId(1) {}
-
-void Phonebook::initializeNextId() {
-    if (contacts.empty()) {
-        nextId = 1;
-    } else {
-        const auto maxIt = std::max_element(contacts.begin(), contacts.end(),
-        [](const Contact& a, const Contact& b){ return a.getId() < b.getId(); });
-        nextId = maxIt->getId() + 1;
+namespace {
+    std::string phoneDigits(const std::string& number) {
+        std::string digits;
+        std::copy_if(number.begin(), number.end(), std::back_inserter(digits),
+                     [](char c){ return std::isdigit(c); });
+        return digits;
     }
-}
-
-void Phonebook::addContact(Contact& contact) {
-    contact.setId(nextId++);
-    contacts.push_back(contact);
-}
 
-void Phonebook::addContactFromStorage(const Contact& contact) {
-    contacts.push_back(contact);
-}
-
-bool Phonebook::deleteContact(int id) {
-    const auto it = std::find_if(contacts.begin(), contacts.end(),
-    [id](const Contact& c) { return c.getId() == id; });
-    if (it != contacts.end()) {
-        contacts.erase(it);
-        return true;
+    template<typename Map>
+    void eraseEntry(Map& index, const typename Map::key_type& key, const int id) {
+        auto [first, last] = index.equal_range(key);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == id) {
+                index.erase(it);
+                return;
+            }
+        }
     }
-    return false;
-}
 
-Contact* Phonebook::findContact(int id) {
-    const auto it = std::find_if(contacts.begin(), contacts.end(),
-    [id](const Contact& c) { return c.getId() == id; });
-    if (it != contacts.end()) {
-        return &(*it);
+    template<typename Map>
+    bool hasOtherEntry(const Map& index, const typename Map::key_type& key, const int ignoreId) {
+        auto [first, last] = index.equal_range(key);
+        return std::any_of(first, last, [ignoreId](const auto& entry) { return entry.second != ignoreId; });
     }
-    return nullptr;
-}
 
-std::vector<Contact> Phonebook::searchContacts(const std::map<SearchField, std::string>& criteria) const {
-    if (criteria.empty()) {
-        return contacts;
-    }
+    std::vector<std::pair<TrigramField, std::string>> buildTrigramQueries(
+        const std::map<SearchField, std::string>& criteria) {
+        std::vector<std::pair<TrigramField, std::string>> queries;
 
-    std::vector<Contact> foundContacts;
+        for (const auto& [field, value] : criteria) {
+            std::string query = validation::trim(value);
+            if (field != SearchField::PHONE) {
+                std::transform(query.begin(), query.end(), query.begin(),
+                               [](unsigned char c) { return std::tolower(c); });
+            }
 
-    for (const Contact& contact : contacts) {
-        bool matchesAllCriteria = true;
+            switch (field) {
+                case SearchField::SURNAME:
+                    queries.emplace_back(TrigramField::SURNAME, query);
+                    break;
+                case SearchField::FORENAME:
+                    queries.emplace_back(TrigramField::FORENAME, query);
+                    break;
+                case SearchField::PATRONYMIC:
+                    queries.emplace_back(TrigramField::PATRONYMIC, query);
+                    break;
+                case SearchField::ADDRESS:
+                    queries.emplace_back(TrigramField::ADDRESS, query);
+                    break;
+                case SearchField::EMAIL:
+                    queries.emplace_back(TrigramField::EMAIL, query);
+                    break;
+                case SearchField::PHONE:
+                    queries.emplace_back(TrigramField::PHONE, validation::phoneSearchDigits(query));
+                    break;
+                default:
+                    break;
+            }
+        }
+        return queries;
+    }
 
+    bool matchesAllCriteria(const Contact& contact, const std::map<SearchField, std::string>& criteria) {
         for (const auto& criterion : criteria) {
             const SearchField field = criterion.first;
             std::string query = validation::trim(criterion.second);
@@ -77,37 +91,25 @@ std::vector<Contact> Phonebook::searchContacts(const std::map<SearchField, std::
                     break;
                 }
                 case SearchField::SURNAME: {
-                    std::string surname = contact.getSurname();
-                    std::transform(surname.begin(), surname.end(), surname.begin(),
-                    [](unsigned char c) { return std::tolower(c); });
-                    if (surname.find(query) != std::string::npos) {
+                    if (contact.getSearchKeys().surname.find(query) != std::string::npos) {
                         currentCriterionMatch = true;
                     }
                     break;
                 }
                 case SearchField::FORENAME: {
-                    std::string forename = contact.getForename();
-                    std::transform(forename.begin(), forename.end(), forename.begin(),
-                    [](unsigned char c) { return std::tolower(c); });
-                    if (forename.find(query) != std::string::npos) {
+                    if (contact.getSearchKeys().forename.find(query) != std::string::npos) {
                         currentCriterionMatch = true;
                     }
                     break;
                 }
                 case SearchField::PATRONYMIC: {
-                    std::string patronymic = contact.getPatronymic();
-                    std::transform(patronymic.begin(), patronymic.end(), patronymic.begin(),
-                    [](unsigned char c) { return std::tolower(c); });
-                    if (patronymic.find(query) != std::string::npos) {
+                    if (contact.getSearchKeys().patronymic.find(query) != std::string::npos) {
                         currentCriterionMatch = true;
                     }
                     break;
                 }
                 case SearchField::ADDRESS: {
-                    std::string address = contact.getAddress();
-                    std::transform(address.begin(), address.end(), address.begin(),
-                    [](unsigned char c) { return std::tolower(c); });
-                    if (address.find(query) != std::string::npos) {
+                    if (contact.getSearchKeys().address.find(query) != std::string::npos) {
                         currentCriterionMatch = true;
                     }
                     break;
@@ -143,45 +145,258 @@ std::vector<Contact> Phonebook::searchContacts(const std::map<SearchField, std::
                     break;
                 }
                 case SearchField::EMAIL: {
-                    std::string email = contact.getEmail();
-                    if (email.find(query) != std::string::npos) {
+                    if (contact.getSearchKeys().email.find(query) != std::string::npos) {
                         currentCriterionMatch = true;
                     }
                     break;
                 }
                 case SearchField::PHONE: {
-                    std::string queryDigits;
-                    std::copy_if(query.begin(), query.end(), std::back_inserter(queryDigits),
-                    [](char c){ return std::isdigit(c); });
-
-                    if (!queryDigits.empty() && queryDigits.front() == '8') {
-                        queryDigits[0] = '7';
-                    }
-
-                    if (queryDigits.empty()) {
-                        currentCriterionMatch = false;
-                        break;
-                    }
-
-                    for (const auto& phone : contact.getPhoneNumbers()) {
-                        std::string storedDigits;
-                        std::copy_if(phone.number.begin(), phone.number.end(), std::back_inserter(storedDigits),
-                        [](char c){ return std::isdigit(c); });
-
-                        if (storedDigits.find(queryDigits) != std::string::npos) {
-                            currentCriterionMatch = true;
-                            break;
-                        }
+                    const std::string queryDigits = validation::phoneSearchDigits(query);
+                    if (!queryDigits.empty() &&
+                        contact.getSearchKeys().phoneDigits.find(queryDigits) != std::string::npos) {
+                        currentCriterionMatch = true;
                     }
                     break;
                 }
             }
             if (!currentCriterionMatch) {
-                matchesAllCriteria = false;
-                break;
+                return false;
             }
         }
-        if (matchesAllCriteria) {
+        return true;
+    }
+
+    bool matchesAnyField(const Contact& contact, const std::string& trimmedQuery, const std::string& lowerQuery,
+                         const std::string& queryDigits) {
+        const ContactSearchKeys& keys = contact.getSearchKeys();
+
+        return keys.id.find(trimmedQuery) != std::string::npos ||
+               keys.surname.find(lowerQuery) != std::string::npos ||
+               keys.forename.find(lowerQuery) != std::string::npos ||
+               keys.patronymic.find(lowerQuery) != std::string::npos ||
+               keys.address.find(lowerQuery) != std::string::npos ||
+               keys.email.find(lowerQuery) != std::string::npos ||
+               (!queryDigits.empty() && keys.phoneDigits.find(queryDigits) != std::string::npos) ||
+               keys.birthDate.find(trimmedQuery) != std::string::npos;
+    }
+}
+
+Phonebook::Phonebook() : nextId(1) {}
+
+void Phonebook::initializeNextId() {
+    compact();
+    if (contacts.empty()) {
+        nextId = 1;
+    } else {
+        const auto maxIt = std::max_element(contacts.begin(), contacts.end(),
+        [](const Contact& a, const Contact& b){ return a.getId() < b.getId(); });
+        nextId = maxIt->getId() + 1;
+    }
+}
+
+void Phonebook::initializeNextId(const int maxStoredId) {
+    initializeNextId();
+    nextId = std::max(nextId, maxStoredId + 1);
+}
+
+void Phonebook::indexContact(const size_t slot) {
+    const Contact& contact = contacts[slot];
+    slotsById[contact.getId()] = slot;
+    idsByEmail.emplace(contact.getEmail(), contact.getId());
+    for (const PhoneNumber& phone : contact.getPhoneNumbers()) {
+        idsByPhoneDigits.emplace(phoneDigits(phone.number), contact.getId());
+    }
+    if (trigramIndex) {
+        trigramIndex->add(contact);
+    }
+    if (sortIndex) {
+        sortIndex->add(contact);
+    }
+}
+
+void Phonebook::unindexContact(const Contact& contact) {
+    slotsById.erase(contact.getId());
+    eraseEntry(idsByEmail, contact.getEmail(), contact.getId());
+    for (const PhoneNumber& phone : contact.getPhoneNumbers()) {
+        eraseEntry(idsByPhoneDigits, phoneDigits(phone.number), contact.getId());
+    }
+    if (trigramIndex) {
+        trigramIndex->remove(contact);
+    }
+    if (sortIndex) {
+        sortIndex->remove(contact);
+    }
+}
+
+void Phonebook::rebuildSlots(const size_t fromSlot) const {
+    for (size_t slot = fromSlot; slot < contacts.size(); ++slot) {
+        slotsById[contacts[slot].getId()] = slot;
+    }
+}
+
+void Phonebook::compact() const {
+    if (deletedSlotCount == 0) {
+        return;
+    }
+
+    const auto isDeleted = [](const Contact& contact) { return contact.getId() == 0; };
+    const auto firstDeleted = std::find_if(contacts.begin(), contacts.end(), isDeleted);
+    const size_t fromSlot = static_cast<size_t>(firstDeleted - contacts.begin());
+    contacts.erase(std::remove_if(firstDeleted, contacts.end(), isDeleted), contacts.end());
+    deletedSlotCount = 0;
+    rebuildSlots(fromSlot);
+}
+
+void Phonebook::rebuildIndexes() {
+    slotsById.clear();
+    idsByEmail.clear();
+    idsByPhoneDigits.clear();
+    if (trigramIndex) {
+        trigramIndex->clear();
+    }
+    const bool sortIndexEnabled = sortIndex.has_value();
+    sortIndex.reset();
+
+    slotsById.reserve(contacts.size());
+    idsByEmail.reserve(contacts.size());
+    idsByPhoneDigits.reserve(contacts.size());
+    for (size_t slot = 0; slot < contacts.size(); ++slot) {
+        indexContact(slot);
+    }
+    setSortIndexEnabled(sortIndexEnabled);
+}
+
+void Phonebook::addContact(Contact& contact) {
+    contact.setId(nextId++);
+    contacts.push_back(contact);
+    indexContact(contacts.size() - 1);
+
+    changedIds.insert(contact.getId());
+    deletedIds.erase(contact.getId());
+}
+
+void Phonebook::addContactFromStorage(const Contact& contact) {
+    contacts.push_back(contact);
+    indexContact(contacts.size() - 1);
+}
+
+void Phonebook::addContactFromStorage(Contact&& contact) {
+    contacts.push_back(std::move(contact));
+    indexContact(contacts.size() - 1);
+}
+
+bool Phonebook::loadFrom(ContactStorage& storage) {
+    class Loader : public ContactVisitor {
+        Phonebook& phonebook;
+
+    public:
+        explicit Loader(Phonebook& phonebook) : phonebook(phonebook) {}
+
+        void reserve(const size_t count) override {
+            phonebook.reserve(count);
+        }
+
+        void visit(Contact&& contact) override {
+            phonebook.addContactFromStorage(std::move(contact));
+        }
+    };
+
+    clear();
+    Loader loader(*this);
+    const bool loaded = storage.loadInto(loader);
+    if (!loaded) {
+        clear();
+    }
+
+    initializeNextId();
+    if (loaded) {
+        markSaved();
+    }
+    return loaded;
+}
+
+void Phonebook::reserve(const size_t count) {
+    contacts.reserve(count);
+    slotsById.reserve(count);
+    idsByEmail.reserve(count);
+    idsByPhoneDigits.reserve(count);
+}
+
+void Phonebook::clear() {
+    contacts.clear();
+    contacts.shrink_to_fit();
+    deletedSlotCount = 0;
+    rebuildIndexes();
+
+    changedIds.clear();
+    deletedIds.clear();
+    fullRewriteRequired = true;
+    orderChanged = false;
+    nextId = 1;
+}
+
+bool Phonebook::updateContact(const Contact& contact) {
+    const auto it = slotsById.find(contact.getId());
+    if (it == slotsById.end()) {
+        return false;
+    }
+
+    const size_t slot = it->second;
+    unindexContact(contacts[slot]);
+    contacts[slot] = contact;
+    indexContact(slot);
+
+    changedIds.insert(contact.getId());
+    return true;
+}
+
+bool Phonebook::deleteContact(int id) {
+    const auto it = slotsById.find(id);
+    if (it != slotsById.end()) {
+        const size_t slot = it->second;
+        unindexContact(contacts[slot]);
+        contacts[slot] = Contact();
+        ++deletedSlotCount;
+
+        changedIds.erase(id);
+        deletedIds.insert(id);
+        return true;
+    }
+    return false;
+}
+
+bool Phonebook::wasDeleted(const int id) const {
+    return deletedIds.count(id) != 0;
+}
+
+const Contact* Phonebook::findContact(int id) const {
+    const auto it = slotsById.find(id);
+    if (it != slotsById.end()) {
+        return &contacts[it->second];
+    }
+    return nullptr;
+}
+
+std::vector<Contact> Phonebook::searchContacts(const std::map<SearchField, std::string>& criteria) const {
+    compact();
+    if (criteria.empty()) {
+        return contacts;
+    }
+
+    std::vector<Contact> foundContacts;
+
+    std::vector<size_t> candidateSlots;
+    if (findCandidateSlots(buildTrigramQueries(criteria), true, candidateSlots)) {
+        for (const size_t slot : candidateSlots) {
+            if (matchesAllCriteria(contacts[slot], criteria)) {
+                foundContacts.push_back(contacts[slot]);
+            }
+        }
+        return foundContacts;
+    }
+
+    for (const Contact& contact : contacts) {
+        if (matchesAllCriteria(contact, criteria)) {
             foundContacts.push_back(contact);
         }
     }
@@ -193,97 +408,97 @@ void Phonebook::sortContacts(const std::vector<SortCriterion>& criteria) {
         return;
     }
 
-    std::stable_sort(contacts.begin(), contacts.end(),
-              [&criteria](const Contact& a, const Contact& b) {
-                  for (const auto& criterion : criteria) {
-                      switch (criterion.field) {
-                          case SortField::ID:
-                              if (a.getId() != b.getId()) {
-                                  return criterion.direction == SortDirection::ASCENDING
-                                             ? a.getId() < b.getId()
-                                             : a.getId() > b.getId();
-                              }
-                              break;
-                          case SortField::SURNAME:
-                              if (a.getSurname() != b.getSurname()) {
-                                  return criterion.direction == SortDirection::ASCENDING
-                                             ? a.getSurname() < b.getSurname()
-                                             : a.getSurname() > b.getSurname();
-                              }
-                              break;
-                          case SortField::FORENAME:
-                              if (a.getForename() != b.getForename()) {
-                                  return criterion.direction == SortDirection::ASCENDING
-                                             ? a.getForename() < b.getForename()
-                                             : a.getForename() > b.getForename();
-                              }
-                              break;
-                          case SortField::PATRONYMIC:
-                              if (a.getPatronymic() != b.getPatronymic()) {
-                                  return criterion.direction == SortDirection::ASCENDING
-                                             ? a.getPatronymic() < b.getPatronymic()
-                                             : a.getPatronymic() > b.getPatronymic();
-                              }
-                              break;
-                          case SortField::ADDRESS:
-                              if (a.getAddress() != b.getAddress()) {
-                                  return criterion.direction == SortDirection::ASCENDING
-                                             ? a.getAddress() < b.getAddress()
-                                             : a.getAddress() > b.getAddress();
-                              }
-                              break;
-                          case SortField::BIRTH_DATE:
-                              if (a.getBirthDate() < b.getBirthDate() || b.getBirthDate() < a.getBirthDate()) {
-                                  return criterion.direction == SortDirection::ASCENDING
-                                             ? a.getBirthDate() < b.getBirthDate()
-                                             : b.getBirthDate() < a.getBirthDate();
-                              }
-                              break;
-                          case SortField::EMAIL:
-                              if (a.getEmail() != b.getEmail()) {
-                                  return criterion.direction == SortDirection::ASCENDING
-                                             ? a.getEmail() < b.getEmail()
-                                             : a.getEmail() > b.getEmail();
-                              }
-                              break;
-                      }
-                  }
-                  return false;
-              });
+    compact();
+    const std::vector<uint32_t> permutation = sortedPermutation(criteria);
+    for (size_t slot = 0; slot < permutation.size(); ++slot) {
+        if (permutation[slot] != slot) {
+            sorting::applyPermutation(contacts, permutation);
+            rebuildSlots(slot);
+            orderChanged = true;
+            return;
+        }
+    }
 }
 
 const std::vector<Contact>& Phonebook::getAllContacts() const {
+    compact();
     return contacts;
 }
 
-bool Phonebook::isEmailUnique(const std::string& email, const int ignoreId) const {
-    const std::string normalizedEmail = validation::normalizeEmail(email);
+std::vector<int> Phonebook::sortedIds(const std::vector<SortCriterion>& criteria) const {
+    compact();
+    std::vector<int> ids;
+    ids.reserve(contacts.size());
+    if (criteria.empty()) {
+        for (const Contact& contact : contacts) {
+            ids.push_back(contact.getId());
+        }
+        return ids;
+    }
 
-    const auto it = std::find_if(contacts.begin(), contacts.end(),
-        [&](const Contact& contact) {
-            return contact.getId() != ignoreId && contact.getEmail() == normalizedEmail;
-        });
+    for (const uint32_t slot : sortedPermutation(criteria)) {
+        ids.push_back(contacts[slot].getId());
+    }
+    return ids;
+}
 
-    return it == contacts.end();
+std::vector<uint32_t> Phonebook::sortedPermutation(const std::vector<SortCriterion>& criteria) const {
+    return sortIndex ? indexedPermutation(criteria) : sorting::sortedPermutation(contacts, criteria);
 }
 
-bool Phonebook::isPhoneNumberUnique(const std::string& number, const int ignoreId) const {
-    const std::string normalizedNumber = validation::normalizePhoneNumber(number);
+std::vector<uint32_t> Phonebook::indexedPermutation(const std::vector<SortCriterion>& criteria) const {
+    std::vector<int> ids;
+    std::vector<size_t> tieEnds;
+    sortIndex->collectIds(criteria.front(), ids, tieEnds);
 
-    for (const Contact& contact : contacts) {
-        if (contact.getId() == ignoreId) {
-            continue;
-        }
-        for (const PhoneNumber& phone : contact.getPhoneNumbers()) {
-            if (phone.number == normalizedNumber) {
-                return false;
+    std::vector<uint32_t> permutation;
+    permutation.reserve(ids.size());
+    for (const int id : ids) {
+        permutation.push_back(static_cast<uint32_t>(slotsById.at(id)));
+    }
+
+    std::vector<std::vector<uint32_t>> ranks(criteria.size() - 1, std::vector<uint32_t>(contacts.size()));
+    std::vector<int> rankedIds;
+    std::vector<size_t> rankTieEnds;
+    for (size_t i = 1; i < criteria.size(); ++i) {
+        sortIndex->collectIds(criteria[i], rankedIds, rankTieEnds);
+        size_t position = 0;
+        for (size_t rank = 0; rank < rankTieEnds.size(); ++rank) {
+            for (; position < rankTieEnds[rank]; ++position) {
+                ranks[i - 1][slotsById.at(rankedIds[position])] = static_cast<uint32_t>(rank);
             }
         }
     }
-    return true;
+
+    size_t groupStart = 0;
+    for (const size_t groupEnd : tieEnds) {
+        if (groupEnd - groupStart > 1) {
+            std::sort(permutation.begin() + static_cast<std::ptrdiff_t>(groupStart),
+                      permutation.begin() + static_cast<std::ptrdiff_t>(groupEnd),
+                      [&ranks](const uint32_t a, const uint32_t b) {
+                          for (const std::vector<uint32_t>& rank : ranks) {
+                              if (rank[a] != rank[b]) {
+                                  return rank[a] < rank[b];
+                              }
+                          }
+                          return a < b;
+                      });
+        }
+        groupStart = groupEnd;
+    }
+    return permutation;
+}
+
+bool Phonebook::isEmailUnique(const std::string& email, const int ignoreId) const {
+    return !hasOtherEntry(idsByEmail, validation::normalizeEmail(email), ignoreId);
+}
+
+bool Phonebook::isPhoneNumberUnique(const std::string& number, const int ignoreId) const {
+    return !hasOtherEntry(idsByPhoneDigits, phoneDigits(validation::normalizePhoneNumber(number)), ignoreId);
 }
 
 std::vector<Contact> Phonebook::searchAllFields(const std::string& query) const {
+    compact();
     std::string trimmedQuery = validation::trim(query);
     if (trimmedQuery.empty()) {
         return contacts;
@@ -295,76 +510,150 @@ std::vector<Contact> Phonebook::searchAllFields(const std::string& query) const
     std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(),
                    [](unsigned char c) { return std::tolower(c); });
 
-    std::string queryDigits;
-    std::copy_if(trimmedQuery.begin(), trimmedQuery.end(), std::back_inserter(queryDigits),
-                 [](char c){ return std::isdigit(c); });
+    const std::string queryDigits = validation::phoneSearchDigits(trimmedQuery);
+
+    std::vector<std::pair<TrigramField, std::string>> trigramQueries = {
+        {TrigramField::ID, trimmedQuery},
+        {TrigramField::SURNAME, lowerQuery},
+        {TrigramField::FORENAME, lowerQuery},
+        {TrigramField::PATRONYMIC, lowerQuery},
+        {TrigramField::ADDRESS, lowerQuery},
+        {TrigramField::BIRTH_DATE, trimmedQuery},
+        {TrigramField::EMAIL, lowerQuery}
+    };
+    if (!queryDigits.empty()) {
+        trigramQueries.emplace_back(TrigramField::PHONE, queryDigits);
+    }
 
-    if (!queryDigits.empty() && queryDigits.front() == '8') {
-        queryDigits[0] = '7';
+    std::vector<size_t> candidateSlots;
+    if (findCandidateSlots(trigramQueries, false, candidateSlots)) {
+        for (const size_t slot : candidateSlots) {
+            if (matchesAnyField(contacts[slot], trimmedQuery, lowerQuery, queryDigits)) {
+                result.push_back(contacts[slot]);
+            }
+        }
+        return result;
     }
 
     for (const auto& contact : contacts) {
-        bool match = false;
-
-        if (std::to_string(contact.getId()).find(trimmedQuery) != std::string::npos) {
-            match = true;
+        if (matchesAnyField(contact, trimmedQuery, lowerQuery, queryDigits)) {
+            result.push_back(contact);
         }
+    }
+    return result;
+}
 
-        auto checkTextValue = [&](const std::string& value) {
-            if (value.empty()) {
-                return false;
-            }
-
-            std::string lowerValue = value;
-            std::transform(lowerValue.begin(), lowerValue.end(), lowerValue.begin(),
-                           [](unsigned char c) { return std::tolower(c); });
-            return lowerValue.find(lowerQuery) != std::string::npos;
-        };
-
-        if (checkTextValue(contact.getSurname()) ||
-            checkTextValue(contact.getForename()) ||
-            checkTextValue(contact.getPatronymic()) ||
-            checkTextValue(contact.getAddress()) ||
-            checkTextValue(contact.getEmail())) {
-            match = true;
-        }
+bool Phonebook::findCandidateSlots(const std::vector<std::pair<TrigramField, std::string>>& queries,
+                                   const bool matchAll, std::vector<size_t>& slots) const {
+    if (!trigramIndex) {
+        return false;
+    }
 
-        if (!match && !queryDigits.empty()) {
-            for (const auto& phone : contact.getPhoneNumbers()) {
-                std::string storedDigits;
-                std::copy_if(phone.number.begin(), phone.number.end(), std::back_inserter(storedDigits),
-                             [](char c){ return std::isdigit(c); });
+    std::vector<int> ids;
+    std::vector<int> fieldIds;
+    std::vector<int> merged;
+    bool hasCandidates = false;
 
-                if (storedDigits.find(queryDigits) != std::string::npos) {
-                    match = true;
-                    break;
-                }
+    for (const auto& [field, query] : queries) {
+        if (!trigramIndex->findCandidates(field, query, fieldIds)) {
+            if (matchAll) {
+                continue;
             }
+            return false;
         }
 
-        const Date birthDate = contact.getBirthDate();
-        std::string dateStr = std::to_string(birthDate.day) + "." + std::to_string(birthDate.month) +
-            "." + std::to_string(birthDate.year);
-        if (dateStr.find(trimmedQuery) != std::string::npos) {
-            match = true;
+        if (!hasCandidates) {
+            ids.swap(fieldIds);
+            hasCandidates = true;
+            continue;
         }
 
-        if (match) {
-            result.push_back(contact);
+        merged.clear();
+        if (matchAll) {
+            std::set_intersection(ids.begin(), ids.end(), fieldIds.begin(), fieldIds.end(),
+                                  std::back_inserter(merged));
+        } else {
+            std::set_union(ids.begin(), ids.end(), fieldIds.begin(), fieldIds.end(),
+                           std::back_inserter(merged));
         }
+        ids.swap(merged);
     }
-    return result;
+
+    if (!hasCandidates) {
+        return false;
+    }
+
+    slots.clear();
+    slots.reserve(ids.size());
+    for (const int id : ids) {
+        slots.push_back(slotsById.at(id));
+    }
+    std::sort(slots.begin(), slots.end());
+    return true;
 }
 
-void Phonebook::reorderContacts(const std::vector<int>& orderedIds) {
-    std::vector<Contact> newOrder;
+bool Phonebook::isTrigramIndexEnabled() const {
+    return trigramIndex.has_value();
+}
 
-    for (const int id : orderedIds) {
-        const Contact* ptr = findContact(id);
-        if (ptr != nullptr) {
-            newOrder.push_back(*ptr);
-        }
+void Phonebook::setTrigramIndexEnabled(const bool enabled) {
+    if (!enabled) {
+        trigramIndex.reset();
+        return;
     }
+    if (trigramIndex) {
+        return;
+    }
+
+    compact();
+    trigramIndex.emplace();
+    for (const Contact& contact : contacts) {
+        trigramIndex->add(contact);
+    }
+}
+
+bool Phonebook::isSortIndexEnabled() const {
+    return sortIndex.has_value();
+}
+
+void Phonebook::setSortIndexEnabled(const bool enabled) {
+    if (!enabled) {
+        sortIndex.reset();
+        return;
+    }
+    if (sortIndex) {
+        return;
+    }
+
+    compact();
+    sortIndex.emplace();
+    sortIndex->rebuild(contacts);
+}
+
+bool Phonebook::hasChanges() const {
+    return fullRewriteRequired || orderChanged || !changedIds.empty() || !deletedIds.empty();
+}
+
+ContactChanges Phonebook::getChanges() const {
+    ContactChanges changes;
+    changes.fullRewrite = fullRewriteRequired;
+    changes.orderChanged = orderChanged;
+
+    changes.upserted.reserve(changedIds.size());
+    for (const int id : changedIds) {
+        changes.upserted.push_back(*findContact(id));
+    }
+    std::sort(changes.upserted.begin(), changes.upserted.end(),
+              [](const Contact& a, const Contact& b) { return a.getId() < b.getId(); });
+
+    changes.deletedIds.assign(deletedIds.begin(), deletedIds.end());
+    std::sort(changes.deletedIds.begin(), changes.deletedIds.end());
+    return changes;
+}
 
-    contacts = newOrder;
+void Phonebook::markSaved() {
+    changedIds.clear();
+    deletedIds.clear();
+    fullRewriteRequired = false;
+    orderChanged = false;
 }
@@ -1,7 +1,16 @@
 #pragma once
 #include "Contact.h"
+#include "ContactStorage.h"
+#include "SortCriterion.h"
+#include "SortIndex.h"
+#include "TrigramIndex.h"
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 enum class SearchField {
@@ -17,49 +26,70 @@ enum class SearchField {
     PHONE
 };
 
-enum class SortField {
-    ID,
-    SURNAME,
-    FORENAME,
-    PATRONYMIC,
-    ADDRESS,
-    BIRTH_DATE,
-    EMAIL
-};
+class Phonebook {
+    mutable std::vector<Contact> contacts;
+    mutable size_t deletedSlotCount = 0;
+    int nextId;
 
-enum class SortDirection {
-    ASCENDING,
-    DESCENDING
-};
+    mutable std::unordered_map<int, size_t> slotsById;
+    std::unordered_multimap<std::string, int> idsByEmail;
+    std::unordered_multimap<std::string, int> idsByPhoneDigits;
+    std::optional<TrigramIndex> trigramIndex;
+    std::optional<SortIndex> sortIndex;
 
-struct SortCriterion {
-    SortField field;
-    SortDirection direction;
-};
+    std::unordered_set<int> changedIds;
+    std::unordered_set<int> deletedIds;
+    bool fullRewriteRequired = true;
+    bool orderChanged = false;
 
-class Phonebook {
-    std::vector<Contact> contacts;
-    int nextId;
+    void indexContact(size_t slot);
+    void unindexContact(const Contact& contact);
+    void rebuildSlots(size_t fromSlot) const;
+    void compact() const;
+    void rebuildIndexes();
+
+    std::vector<uint32_t> sortedPermutation(const std::vector<SortCriterion>& criteria) const;
+    std::vector<uint32_t> indexedPermutation(const std::vector<SortCriterion>& criteria) const;
+
+    bool findCandidateSlots(const std::vector<std::pair<TrigramField, std::string>>& queries, bool matchAll,
+                            std::vector<size_t>& slots) const;
 
 public:
     Phonebook();
 
     void initializeNextId();
+    void initializeNextId(int maxStoredId);
 
     void addContact(Contact& contact);
     void addContactFromStorage(const Contact& contact);
+    void addContactFromStorage(Contact&& contact);
+    bool loadFrom(ContactStorage& storage);
+    void reserve(size_t count);
+    void clear();
 
+    bool updateContact(const Contact& contact);
     bool deleteContact(int id);
+    bool wasDeleted(int id) const;
 
-    Contact* findContact(int id);
+    const Contact* findContact(int id) const;
     std::vector<Contact> searchContacts(const std::map<SearchField, std::string>& criteria) const;
     void sortContacts(const std::vector<SortCriterion>& criteria);
+    std::vector<int> sortedIds(const std::vector<SortCriterion>& criteria) const;
     const std::vector<Contact>& getAllContacts() const;
 
     std::vector<Contact> searchAllFields(const std::string& query) const;
 
-    void reorderContacts(const std::vector<int>& orderedIds);
+    bool isTrigramIndexEnabled() const;
+    void setTrigramIndexEnabled(bool enabled);
+
+    bool isSortIndexEnabled() const;
+    void setSortIndexEnabled(bool enabled);
+
 
     bool isEmailUnique(const std::string& email, int ignoreId) const;
     bool isPhoneNumberUnique(const std::string& number, int ignoreId) const;
+
+    bool hasChanges() const;
+    ContactChanges getChanges() const;
+    void markSaved();
 };
@@ -1,39 +1,22 @@
-QT += core gui sql widgets
+TEMPLATE = subdirs
 
-TEMPLATE = app
+SUBDIRS += \
+    core \
+    sql \
+    app \
+    batch
 
-TARGET = phonebook
+core.file = phonebook_core.pro
+sql.file = phonebook_sql.pro
+app.file = phonebook_app.pro
+batch.file = phonebook_batch.pro
 
-CONFIG += c++20
+sql.depends = core
+app.depends = core sql
+batch.depends = core sql
 
-CONFIG += console
-
-SOURCES += \
-    ContactDialog.cpp \
-    SearchDialog.cpp \
-    SortDialog.cpp \
-    main.cpp \
-    Phonebook.cpp \
-    Contact.cpp \
-    FileStorage.cpp \
-    validation.cpp \
-    cli.cpp \
-    MainWindow.cpp \
-    DbStorage.cpp
-
-HEADERS += \
-    ContactDialog.h \
-    Phonebook.h \
-    Contact.h \
-    Date.h \
-    FileStorage.h \
-    SearchDialog.h \
-    SortDialog.h \
-    validation.h \
-    cli.h \
-    MainWindow.h \
-    DbStorage.h \
-    ContactStorage.h
-
-DISTFILES += \
-    contacts.txt
+phonebook_bench {
+    SUBDIRS += bench
+    bench.file = bench/bench.pro
+    bench.depends = core sql
+}
@@ -0,0 +1,367 @@
+#include "SnapshotStorage.h"
+#include "FileStorage.h"
+#include "MappedFile.h"
+#include "fileio.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+    constexpr char SNAPSHOT_MAGIC[8] = {'P', 'H', 'B', 'K', 'S', 'N', 'A', 'P'};
+    constexpr uint32_t SNAPSHOT_VERSION = 1;
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr uint32_t NO_FAILED_RECORD = UINT32_MAX;
+    constexpr size_t DECODE_BLOCK_RECORDS = 1 << 16;
+
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t contactCount;
+        uint32_t phoneCount;
+        uint64_t stringTableSize;
+    };
+
+    struct ContactRecord {
+        int32_t id;
+        uint32_t birthDate;
+        uint32_t surname;
+        uint32_t forename;
+        uint32_t patronymic;
+        uint32_t address;
+        uint32_t email;
+        uint32_t firstPhone;
+        uint32_t phoneCount;
+    };
+
+    struct PhoneRecord {
+        uint32_t type;
+        uint32_t number;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 32);
+    static_assert(sizeof(ContactRecord) == 36);
+    static_assert(sizeof(PhoneRecord) == 8);
+
+    uint32_t packDate(const Date& date) {
+        return static_cast<uint32_t>(date.year) << 9 | static_cast<uint32_t>(date.month) << 5 |
+               static_cast<uint32_t>(date.day);
+    }
+
+    Date unpackDate(const uint32_t packed) {
+        return Date(static_cast<int>(packed & 0x1F), static_cast<int>(packed >> 5 & 0x0F),
+                    static_cast<int>(packed >> 9));
+    }
+
+    class StringTable {
+        std::string data;
+        std::unordered_map<std::string, uint32_t> sharedOffsets;
+        bool overflow = false;
+
+    public:
+        uint32_t add(const std::string& value) {
+            if (data.size() > UINT32_MAX || value.size() > UINT32_MAX) {
+                overflow = true;
+                return 0;
+            }
+            const auto offset = static_cast<uint32_t>(data.size());
+            const auto length = static_cast<uint32_t>(value.size());
+            data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            data += value;
+            return offset;
+        }
+
+        uint32_t addShared(const std::string& value) {
+            const auto it = sharedOffsets.find(value);
+            if (it != sharedOffsets.end()) {
+                return it->second;
+            }
+            const uint32_t offset = add(value);
+            sharedOffsets.emplace(value, offset);
+            return offset;
+        }
+
+        bool overflowed() const {
+            return overflow;
+        }
+
+        const std::string& bytes() const {
+            return data;
+        }
+    };
+
+    class SnapshotReader {
+        std::string_view strings;
+
+    public:
+        explicit SnapshotReader(const std::string_view strings) : strings(strings) {}
+
+        bool contains(const uint32_t offset) const {
+            uint32_t length;
+            if (offset > strings.size() || strings.size() - offset < sizeof(length)) {
+                return false;
+            }
+            std::memcpy(&length, strings.data() + offset, sizeof(length));
+            return strings.size() - offset - sizeof(length) >= length;
+        }
+
+        void read(const uint32_t offset, std::string& value) const {
+            uint32_t length;
+            std::memcpy(&length, strings.data() + offset, sizeof(length));
+            value.assign(strings.data() + offset + sizeof(length), length);
+        }
+    };
+
+    struct SnapshotView {
+        const char* contactRecords;
+        const char* phoneRecords;
+        uint32_t phoneCount;
+        SnapshotReader strings;
+    };
+
+    ContactRecord readContactRecord(const SnapshotView& snapshot, const size_t index) {
+        ContactRecord record {};
+        std::memcpy(&record, snapshot.contactRecords + uint64_t(index) * sizeof(record), sizeof(record));
+        return record;
+    }
+
+    PhoneRecord readPhoneRecord(const SnapshotView& snapshot, const size_t index) {
+        PhoneRecord record {};
+        std::memcpy(&record, snapshot.phoneRecords + uint64_t(index) * sizeof(record), sizeof(record));
+        return record;
+    }
+
+    uint32_t findCorruptContact(const SnapshotView& snapshot, const uint32_t contactCount) {
+        const SnapshotReader& strings = snapshot.strings;
+        for (uint32_t i = 0; i < contactCount; ++i) {
+            const ContactRecord record = readContactRecord(snapshot, i);
+            const bool recordOk = strings.contains(record.surname) && strings.contains(record.forename) &&
+                                  strings.contains(record.patronymic) && strings.contains(record.address) &&
+                                  strings.contains(record.email) && record.firstPhone <= snapshot.phoneCount &&
+                                  snapshot.phoneCount - record.firstPhone >= record.phoneCount;
+            if (!recordOk) {
+                return i;
+            }
+        }
+        return NO_FAILED_RECORD;
+    }
+
+    uint32_t findCorruptPhone(const SnapshotView& snapshot) {
+        for (uint32_t i = 0; i < snapshot.phoneCount; ++i) {
+            const PhoneRecord record = readPhoneRecord(snapshot, i);
+            if (!snapshot.strings.contains(record.type) || !snapshot.strings.contains(record.number)) {
+                return i;
+            }
+        }
+        return NO_FAILED_RECORD;
+    }
+
+    void decodeContacts(const SnapshotView& snapshot, const size_t first, const size_t last, Contact* contacts) {
+        const SnapshotReader& strings = snapshot.strings;
+        std::string surname, forename, patronymic, address, email, type, number;
+
+        for (size_t i = first; i < last; ++i) {
+            const ContactRecord record = readContactRecord(snapshot, i);
+            strings.read(record.surname, surname);
+            strings.read(record.forename, forename);
+            strings.read(record.patronymic, patronymic);
+            strings.read(record.address, address);
+            strings.read(record.email, email);
+
+            Contact& contact = contacts[i - first];
+            contact.setId(record.id);
+            contact.setSurname(surname);
+            contact.setForename(forename);
+            contact.setPatronymic(patronymic);
+            contact.setAddress(address);
+            contact.setBirthDate(unpackDate(record.birthDate));
+            contact.setEmail(email);
+
+            for (uint32_t phone = 0; phone < record.phoneCount; ++phone) {
+                const PhoneRecord phoneRecord = readPhoneRecord(snapshot, record.firstPhone + phone);
+                strings.read(phoneRecord.type, type);
+                strings.read(phoneRecord.number, number);
+                contact.addPhoneNumber(type, number);
+            }
+        }
+    }
+}
+
+bool SnapshotStorage::loadInto(ContactVisitor& visitor) {
+    lastError.clear();
+    MappedFile file;
+
+    if (!file.open(filename)) {
+        lastError = "Cannot open file '" + filename + "' for reading.";
+        return false;
+    }
+
+    const std::string_view buffer = file.view();
+    SnapshotHeader header {};
+    if (buffer.size() < sizeof(header)) {
+        lastError = "File '" + filename + "' is not a phonebook snapshot.";
+        return false;
+    }
+    std::memcpy(&header, buffer.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        lastError = "File '" + filename + "' is not a phonebook snapshot.";
+        return false;
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        lastError = "Snapshot '" + filename + "' was written with a different byte order.";
+        return false;
+    }
+    if (header.version != SNAPSHOT_VERSION) {
+        lastError = "Snapshot '" + filename + "' has unsupported version " + std::to_string(header.version) + ".";
+        return false;
+    }
+
+    const uint64_t contactsSize = uint64_t(header.contactCount) * sizeof(ContactRecord);
+    const uint64_t phonesSize = uint64_t(header.phoneCount) * sizeof(PhoneRecord);
+    const uint64_t bodySize = buffer.size() - sizeof(header);
+    if (contactsSize > bodySize || phonesSize > bodySize - contactsSize ||
+        header.stringTableSize != bodySize - contactsSize - phonesSize) {
+        lastError = "Snapshot '" + filename + "' is truncated or corrupted.";
+        return false;
+    }
+
+    const char* contactRecords = buffer.data() + sizeof(header);
+    const char* phoneRecords = contactRecords + contactsSize;
+    const SnapshotReader strings(std::string_view(phoneRecords + phonesSize, header.stringTableSize));
+    const SnapshotView snapshot {contactRecords, phoneRecords, header.phoneCount, strings};
+
+    const uint32_t corruptContact = findCorruptContact(snapshot, header.contactCount);
+    if (corruptContact != NO_FAILED_RECORD) {
+        lastError = "Snapshot '" + filename + "': record " + std::to_string(uint64_t(corruptContact) + 1) +
+                    " is corrupted.";
+        return false;
+    }
+    const uint32_t corruptPhone = findCorruptPhone(snapshot);
+    if (corruptPhone != NO_FAILED_RECORD) {
+        lastError = "Snapshot '" + filename + "': phone record " + std::to_string(uint64_t(corruptPhone) + 1) +
+                    " is corrupted.";
+        return false;
+    }
+
+    visitor.reserve(header.contactCount);
+
+    const size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    const size_t waveRecords = threadCount * DECODE_BLOCK_RECORDS;
+    std::vector<Contact> decoded;
+
+    for (size_t waveFirst = 0; waveFirst < header.contactCount; waveFirst += waveRecords) {
+        const size_t waveLast = std::min<size_t>(waveFirst + waveRecords, header.contactCount);
+        const size_t blockCount = (waveLast - waveFirst + DECODE_BLOCK_RECORDS - 1) / DECODE_BLOCK_RECORDS;
+        decoded.assign(waveLast - waveFirst, Contact());
+
+        if (blockCount == 1) {
+            decodeContacts(snapshot, waveFirst, waveLast, decoded.data());
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(blockCount);
+            for (size_t block = 0; block < blockCount; ++block) {
+                const size_t first = waveFirst + block * DECODE_BLOCK_RECORDS;
+                const size_t last = std::min(first + DECODE_BLOCK_RECORDS, waveLast);
+                workers.emplace_back([&, first, last]() {
+                    decodeContacts(snapshot, first, last, decoded.data() + (first - waveFirst));
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        for (Contact& contact : decoded) {
+            visitor.visit(std::move(contact));
+        }
+    }
+    return true;
+}
+
+bool SnapshotStorage::saveFrom(const ContactProducer& producer) {
+    lastError.clear();
+
+    std::vector<ContactRecord> contactRecords;
+    std::vector<PhoneRecord> phoneRecords;
+    StringTable strings;
+
+    while (const Contact* producedContact = producer()) {
+        const Contact& contact = *producedContact;
+        ContactRecord record {};
+        record.id = contact.getId();
+        record.birthDate = packDate(contact.getBirthDate());
+        record.surname = strings.add(contact.getSurname());
+        record.forename = strings.add(contact.getForename());
+        record.patronymic = strings.addShared(contact.getPatronymic());
+        record.address = strings.add(contact.getAddress());
+        record.email = strings.add(contact.getEmail());
+        record.firstPhone = static_cast<uint32_t>(phoneRecords.size());
+
+        for (const PhoneNumber& phone : contact.getPhoneNumbers()) {
+            phoneRecords.push_back({strings.addShared(phone.type), strings.add(phone.number)});
+        }
+        record.phoneCount = static_cast<uint32_t>(phoneRecords.size()) - record.firstPhone;
+        contactRecords.push_back(record);
+
+        if (strings.overflowed() || contactRecords.size() >= NO_FAILED_RECORD ||
+            phoneRecords.size() >= NO_FAILED_RECORD) {
+            lastError = "Cannot save snapshot '" + filename + "': it exceeds the 4 GiB snapshot format limit.";
+            return false;
+        }
+    }
+
+    SnapshotHeader header {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.contactCount = static_cast<uint32_t>(contactRecords.size());
+    header.phoneCount = static_cast<uint32_t>(phoneRecords.size());
+    header.stringTableSize = strings.bytes().size();
+
+    return fileio::writeFileAtomically(filename, [&](std::FILE* file) {
+        return std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+               std::fwrite(contactRecords.data(), sizeof(ContactRecord), contactRecords.size(), file) ==
+                   contactRecords.size() &&
+               std::fwrite(phoneRecords.data(), sizeof(PhoneRecord), phoneRecords.size(), file) ==
+                   phoneRecords.size() &&
+               std::fwrite(strings.bytes().data(), 1, strings.bytes().size(), file) == strings.bytes().size();
+    }, lastError);
+}
+
+bool SnapshotStorage::convertFromText(const std::string& textFilename, const std::string& snapshotFilename,
+                                      std::string& error) {
+    FileStorage text(textFilename);
+    const std::vector<Contact> contacts = text.load();
+    if (!text.getLastError().empty()) {
+        error = text.getLastError();
+        return false;
+    }
+
+    SnapshotStorage snapshot(snapshotFilename);
+    if (!snapshot.save(contacts)) {
+        error = snapshot.getLastError();
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotStorage::convertToText(const std::string& snapshotFilename, const std::string& textFilename,
+                                    std::string& error) {
+    SnapshotStorage snapshot(snapshotFilename);
+    const std::vector<Contact> contacts = snapshot.load();
+    if (!snapshot.getLastError().empty()) {
+        error = snapshot.getLastError();
+        return false;
+    }
+
+    FileStorage text(textFilename);
+    if (!text.save(contacts)) {
+        error = text.getLastError();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "ContactStorage.h"
+#include <string>
+#include <utility>
+
+class SnapshotStorage : public ContactStorage {
+    std::string filename;
+public:
+    explicit SnapshotStorage(std::string filename) : filename(std::move(filename)) {}
+
+    bool loadInto(ContactVisitor& visitor) override;
+    bool saveFrom(const ContactProducer& producer) override;
+
+    static bool convertFromText(const std::string& textFilename, const std::string& snapshotFilename,
+                                std::string& error);
+    static bool convertToText(const std::string& snapshotFilename, const std::string& textFilename,
+                              std::string& error);
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+enum class SortField {
+    ID,
+    SURNAME,
+    FORENAME,
+    PATRONYMIC,
+    ADDRESS,
+    BIRTH_DATE,
+    EMAIL
+};
+
+enum class SortDirection {
+    ASCENDING,
+    DESCENDING
+};
+
+struct SortCriterion {
+    SortField field;
+    SortDirection direction;
+};
@@ -0,0 +1,118 @@
+#include "SortIndex.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    template<typename Key>
+    bool sameKey(const Key& left, const Key& right) {
+        return !(left < right) && !(right < left);
+    }
+
+    template<typename Entries, typename KeyOf>
+    void rebuildEntries(Entries& entries, const std::vector<Contact>& contacts, const KeyOf& keyOf) {
+        std::vector<typename Entries::value_type> sorted;
+        sorted.reserve(contacts.size());
+        for (const Contact& contact : contacts) {
+            sorted.emplace_back(keyOf(contact), contact.getId());
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        entries.clear();
+        for (auto& entry : sorted) {
+            entries.emplace_hint(entries.end(), std::move(entry));
+        }
+    }
+
+    template<typename Entries>
+    void collectEntries(const Entries& entries, const SortDirection direction, std::vector<int>& ids,
+                        std::vector<size_t>& tieEnds) {
+        if (direction == SortDirection::ASCENDING) {
+            for (auto it = entries.begin(); it != entries.end(); ++it) {
+                if (it != entries.begin() && !sameKey(std::prev(it)->first, it->first)) {
+                    tieEnds.push_back(ids.size());
+                }
+                ids.push_back(it->second);
+            }
+            if (!ids.empty()) {
+                tieEnds.push_back(ids.size());
+            }
+            return;
+        }
+
+        auto groupEnd = entries.end();
+        while (groupEnd != entries.begin()) {
+            auto groupBegin = std::prev(groupEnd);
+            while (groupBegin != entries.begin() && sameKey(std::prev(groupBegin)->first, groupBegin->first)) {
+                --groupBegin;
+            }
+            for (auto it = groupBegin; it != groupEnd; ++it) {
+                ids.push_back(it->second);
+            }
+            tieEnds.push_back(ids.size());
+            groupEnd = groupBegin;
+        }
+    }
+}
+
+void SortIndex::add(const Contact& contact) {
+    const int id = contact.getId();
+    byId.emplace(id, id);
+    bySurname.emplace(contact.getSurname(), id);
+    byForename.emplace(contact.getForename(), id);
+    byPatronymic.emplace(contact.getPatronymic(), id);
+    byAddress.emplace(contact.getAddress(), id);
+    byBirthDate.emplace(contact.getBirthDate(), id);
+    byEmail.emplace(contact.getEmail(), id);
+}
+
+void SortIndex::remove(const Contact& contact) {
+    const int id = contact.getId();
+    byId.erase({id, id});
+    bySurname.erase({contact.getSurname(), id});
+    byForename.erase({contact.getForename(), id});
+    byPatronymic.erase({contact.getPatronymic(), id});
+    byAddress.erase({contact.getAddress(), id});
+    byBirthDate.erase({contact.getBirthDate(), id});
+    byEmail.erase({contact.getEmail(), id});
+}
+
+void SortIndex::rebuild(const std::vector<Contact>& contacts) {
+    rebuildEntries(byId, contacts, [](const Contact& contact) { return contact.getId(); });
+    rebuildEntries(bySurname, contacts, [](const Contact& contact) { return contact.getSurname(); });
+    rebuildEntries(byForename, contacts, [](const Contact& contact) { return contact.getForename(); });
+    rebuildEntries(byPatronymic, contacts, [](const Contact& contact) { return contact.getPatronymic(); });
+    rebuildEntries(byAddress, contacts, [](const Contact& contact) { return contact.getAddress(); });
+    rebuildEntries(byBirthDate, contacts, [](const Contact& contact) { return contact.getBirthDate(); });
+    rebuildEntries(byEmail, contacts, [](const Contact& contact) { return contact.getEmail(); });
+}
+
+void SortIndex::collectIds(const SortCriterion& criterion, std::vector<int>& ids,
+                           std::vector<size_t>& tieEnds) const {
+    ids.clear();
+    tieEnds.clear();
+    ids.reserve(byId.size());
+
+    switch (criterion.field) {
+        case SortField::ID:
+            collectEntries(byId, criterion.direction, ids, tieEnds);
+            break;
+        case SortField::SURNAME:
+            collectEntries(bySurname, criterion.direction, ids, tieEnds);
+            break;
+        case SortField::FORENAME:
+            collectEntries(byForename, criterion.direction, ids, tieEnds);
+            break;
+        case SortField::PATRONYMIC:
+            collectEntries(byPatronymic, criterion.direction, ids, tieEnds);
+            break;
+        case SortField::ADDRESS:
+            collectEntries(byAddress, criterion.direction, ids, tieEnds);
+            break;
+        case SortField::BIRTH_DATE:
+            collectEntries(byBirthDate, criterion.direction, ids, tieEnds);
+            break;
+        case SortField::EMAIL:
+            collectEntries(byEmail, criterion.direction, ids, tieEnds);
+            break;
+    }
+}
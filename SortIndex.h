@@ -0,0 +1,27 @@
+#pragma once
+#include "Contact.h"
+#include "SortCriterion.h"
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class SortIndex {
+    template<typename Key>
+    using Entries = std::set<std::pair<Key, int>>;
+
+    Entries<int> byId;
+    Entries<std::string> bySurname;
+    Entries<std::string> byForename;
+    Entries<std::string> byPatronymic;
+    Entries<std::string> byAddress;
+    Entries<Date> byBirthDate;
+    Entries<std::string> byEmail;
+
+public:
+    void add(const Contact& contact);
+    void remove(const Contact& contact);
+    void rebuild(const std::vector<Contact>& contacts);
+
+    void collectIds(const SortCriterion& criterion, std::vector<int>& ids, std::vector<size_t>& tieEnds) const;
+};
@@ -0,0 +1,150 @@
+#include "SqliteStorage.h"
+#include "ContactRowReader.h"
+#include "ContactRowWriter.h"
+#include <QSqlError>
+#include <atomic>
+#include <utility>
+
+namespace {
+    std::atomic<int> nextConnectionNumber{0};
+}
+
+SqliteStorage::SqliteStorage(std::string filename)
+    : connectionName(QString::fromStdString("phonebook_sqlite_" + std::to_string(nextConnectionNumber++))),
+      filename(std::move(filename)) {}
+
+SqliteStorage::~SqliteStorage() {
+    if (database.isOpen()) {
+        database.close();
+    }
+    database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+bool SqliteStorage::init() {
+    database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    database.setDatabaseName(QString::fromStdString(filename));
+
+    if (!database.open()) {
+        lastError = database.lastError().text().toStdString();
+        return false;
+    }
+
+    QSqlQuery query(database);
+    const char* const pragmas[] = {
+        "PRAGMA journal_mode = WAL",
+        "PRAGMA synchronous = NORMAL",
+        "PRAGMA foreign_keys = ON"
+    };
+
+    for (const char* pragma : pragmas) {
+        if (!query.exec(pragma)) {
+            lastError = query.lastError().text().toStdString();
+            return false;
+        }
+    }
+
+    return createTables();
+}
+
+bool SqliteStorage::loadInto(ContactVisitor& visitor) {
+    if (!database.isOpen()) {
+        return true;
+    }
+
+    QSqlQuery countQuery(database);
+    if (countQuery.exec("SELECT COUNT(*) FROM contacts") && countQuery.next()) {
+        visitor.reserve(static_cast<size_t>(countQuery.value(0).toLongLong()));
+    }
+
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT id, surname, forename, patronymic, address, birth_day, birth_month, birth_year, email "
+                    "FROM contacts ORDER BY id")) {
+        lastError = query.lastError().text().toStdString();
+        return false;
+    }
+
+    QSqlQuery phoneQuery(database);
+    phoneQuery.setForwardOnly(true);
+    if (!phoneQuery.exec("SELECT contact_id, type, number FROM phones ORDER BY contact_id, id")) {
+        lastError = phoneQuery.lastError().text().toStdString();
+        return false;
+    }
+
+    ContactRowReader reader;
+    if (!reader.readAll(query, phoneQuery, visitor)) {
+        lastError = reader.getLastError();
+        return false;
+    }
+    return true;
+}
+
+bool SqliteStorage::saveFrom(const ContactProducer& producer) {
+    if (!database.isOpen()) {
+        return false;
+    }
+
+    ContactRowWriter writer(database);
+    writer.begin();
+
+    if (!writer.exec("DELETE FROM phones") || !writer.exec("DELETE FROM contacts") ||
+        !writer.insertContacts(producer) || !writer.commit()) {
+        lastError = writer.getLastError();
+        return false;
+    }
+    return true;
+}
+
+bool SqliteStorage::saveChanges(const std::vector<Contact>& contacts, const ContactChanges& changes) {
+    if (changes.fullRewrite) {
+        return save(contacts);
+    }
+
+    if (!database.isOpen()) {
+        return false;
+    }
+
+    ContactRowWriter writer(database);
+    writer.begin();
+
+    if (!writer.applyChanges(changes) || !writer.commit()) {
+        lastError = writer.getLastError();
+        return false;
+    }
+    return true;
+}
+
+bool SqliteStorage::createTables() {
+    QSqlQuery query(database);
+
+    const char* const statements[] = {
+        "CREATE TABLE IF NOT EXISTS contacts ("
+        "id INTEGER PRIMARY KEY, "
+        "surname TEXT NOT NULL, "
+        "forename TEXT NOT NULL, "
+        "patronymic TEXT, "
+        "address TEXT, "
+        "birth_day INT, "
+        "birth_month INT, "
+        "birth_year INT, "
+        "email TEXT NOT NULL)",
+        "CREATE TABLE IF NOT EXISTS phones ("
+        "id INTEGER PRIMARY KEY, "
+        "contact_id INTEGER REFERENCES contacts(id) ON DELETE CASCADE, "
+        "type TEXT NOT NULL, "
+        "number TEXT NOT NULL)",
+        "CREATE INDEX IF NOT EXISTS phones_contact_id_idx ON phones (contact_id)",
+        "CREATE INDEX IF NOT EXISTS phones_number_idx ON phones (number)",
+        "CREATE INDEX IF NOT EXISTS contacts_email_idx ON contacts (email)",
+        "CREATE INDEX IF NOT EXISTS contacts_birth_date_idx ON contacts (birth_year, birth_month, birth_day)"
+    };
+
+    for (const char* statement : statements) {
+        if (!query.exec(statement)) {
+            lastError = query.lastError().text().toStdString();
+            return false;
+        }
+    }
+    return true;
+}
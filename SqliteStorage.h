@@ -0,0 +1,25 @@
+#pragma once
+#include "ContactStorage.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <string>
+#include <vector>
+
+class SqliteStorage : public ContactStorage {
+public:
+    explicit SqliteStorage(std::string filename);
+    ~SqliteStorage() override;
+
+    bool init();
+
+    bool loadInto(ContactVisitor& visitor) override;
+    bool saveFrom(const ContactProducer& producer) override;
+    bool saveChanges(const std::vector<Contact>& contacts, const ContactChanges& changes) override;
+
+private:
+    QSqlDatabase database;
+    QString connectionName;
+    std::string filename;
+
+    bool createTables();
+};
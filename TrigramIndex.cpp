@@ -0,0 +1,106 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+
+void TrigramIndex::collectTrigrams(const TrigramField field, const std::string& value,
+                                   std::vector<uint32_t>& trigrams) {
+    const uint32_t prefix = static_cast<uint32_t>(field) << 24;
+    for (size_t i = 0; i + MIN_QUERY_LENGTH <= value.size(); ++i) {
+        trigrams.push_back(prefix |
+                           static_cast<uint32_t>(static_cast<unsigned char>(value[i])) << 16 |
+                           static_cast<uint32_t>(static_cast<unsigned char>(value[i + 1])) << 8 |
+                           static_cast<uint32_t>(static_cast<unsigned char>(value[i + 2])));
+    }
+}
+
+void TrigramIndex::collectTrigrams(const Contact& contact, std::vector<uint32_t>& trigrams) {
+    const ContactSearchKeys& keys = contact.getSearchKeys();
+    collectTrigrams(TrigramField::ID, keys.id, trigrams);
+    collectTrigrams(TrigramField::SURNAME, keys.surname, trigrams);
+    collectTrigrams(TrigramField::FORENAME, keys.forename, trigrams);
+    collectTrigrams(TrigramField::PATRONYMIC, keys.patronymic, trigrams);
+    collectTrigrams(TrigramField::ADDRESS, keys.address, trigrams);
+    collectTrigrams(TrigramField::BIRTH_DATE, keys.birthDate, trigrams);
+    collectTrigrams(TrigramField::EMAIL, keys.email, trigrams);
+    collectTrigrams(TrigramField::PHONE, keys.phoneDigits, trigrams);
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+void TrigramIndex::add(const Contact& contact) {
+    std::vector<uint32_t> trigrams;
+    collectTrigrams(contact, trigrams);
+
+    const int id = contact.getId();
+    for (const uint32_t trigram : trigrams) {
+        std::vector<int>& ids = postings[trigram];
+        if (ids.empty() || ids.back() < id) {
+            ids.push_back(id);
+        } else {
+            const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+            if (*it != id) {
+                ids.insert(it, id);
+            }
+        }
+    }
+}
+
+void TrigramIndex::remove(const Contact& contact) {
+    std::vector<uint32_t> trigrams;
+    collectTrigrams(contact, trigrams);
+
+    const int id = contact.getId();
+    for (const uint32_t trigram : trigrams) {
+        const auto postingIt = postings.find(trigram);
+        if (postingIt == postings.end()) {
+            continue;
+        }
+
+        std::vector<int>& ids = postingIt->second;
+        const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it != ids.end() && *it == id) {
+            ids.erase(it);
+        }
+        if (ids.empty()) {
+            postings.erase(postingIt);
+        }
+    }
+}
+
+void TrigramIndex::clear() {
+    postings.clear();
+}
+
+bool TrigramIndex::findCandidates(const TrigramField field, const std::string& query, std::vector<int>& ids) const {
+    ids.clear();
+    if (query.size() < MIN_QUERY_LENGTH) {
+        return false;
+    }
+
+    std::vector<uint32_t> trigrams;
+    collectTrigrams(field, query, trigrams);
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    std::vector<const std::vector<int>*> lists;
+    for (const uint32_t trigram : trigrams) {
+        const auto it = postings.find(trigram);
+        if (it == postings.end()) {
+            return true;
+        }
+        lists.push_back(&it->second);
+    }
+
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() < b->size(); });
+
+    ids = *lists.front();
+    std::vector<int> intersection;
+    for (size_t i = 1; i < lists.size() && !ids.empty(); ++i) {
+        intersection.clear();
+        std::set_intersection(ids.begin(), ids.end(), lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(intersection));
+        ids.swap(intersection);
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "Contact.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class TrigramField : uint8_t {
+    ID,
+    SURNAME,
+    FORENAME,
+    PATRONYMIC,
+    ADDRESS,
+    BIRTH_DATE,
+    EMAIL,
+    PHONE
+};
+
+class TrigramIndex {
+    std::unordered_map<uint32_t, std::vector<int>> postings;
+
+    static void collectTrigrams(TrigramField field, const std::string& value, std::vector<uint32_t>& trigrams);
+    static void collectTrigrams(const Contact& contact, std::vector<uint32_t>& trigrams);
+
+public:
+    static constexpr size_t MIN_QUERY_LENGTH = 3;
+
+    void add(const Contact& contact);
+    void remove(const Contact& contact);
+    void clear();
+
+    bool findCandidates(TrigramField field, const std::string& query, std::vector<int>& ids) const;
+};
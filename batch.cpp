@@ -0,0 +1,418 @@
+#include "batch.h"
+#include "DbStorage.h"
+#include "FileStorage.h"
+#include "SnapshotStorage.h"
+#include "SqliteStorage.h"
+#include "validation.h"
+#include <QCoreApplication>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace {
+    const std::map<std::string, SearchField> searchFieldsByName = {
+        {"id", SearchField::ID},
+        {"surname", SearchField::SURNAME},
+        {"forename", SearchField::FORENAME},
+        {"patronymic", SearchField::PATRONYMIC},
+        {"address", SearchField::ADDRESS},
+        {"day", SearchField::BIRTH_DAY},
+        {"month", SearchField::BIRTH_MONTH},
+        {"year", SearchField::BIRTH_YEAR},
+        {"email", SearchField::EMAIL},
+        {"phone", SearchField::PHONE}
+    };
+
+    struct Options {
+        std::string storage = "file";
+        std::string path;
+        std::string script;
+        std::vector<std::string> command;
+    };
+
+    void printUsage(std::ostream& out) {
+        out << "Usage: phonebook --batch OPTIONS (--script FILE | COMMAND [ARGS...])\n"
+               "       phonebook_batch OPTIONS (--script FILE | COMMAND [ARGS...])\n"
+               "Options: [--storage file|journal|snapshot|sqlite|db] [--file PATH]\n"
+               "Commands:\n"
+               "  count\n"
+               "  list\n"
+               "  search FIELD=VALUE...   fields: id surname forename patronymic address day month year email phone\n"
+               "  import PATH             add contacts from a contacts.txt-style file, skipping duplicates\n"
+               "  export PATH             write the phonebook to a contacts.txt-style file\n"
+               "  dedupe                  report contacts with the same name and birth date\n"
+               "  delete ID\n"
+               "Use '--script -' to read commands from standard input. Changes are saved on success." << std::endl;
+    }
+
+    std::string jsonString(const std::string& value) {
+        std::string result = "\"";
+        for (const char c : value) {
+            switch (c) {
+                case '"':
+                    result += "\\\"";
+                    break;
+                case '\\':
+                    result += "\\\\";
+                    break;
+                case '\n':
+                    result += "\\n";
+                    break;
+                case '\r':
+                    result += "\\r";
+                    break;
+                case '\t':
+                    result += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                        result += buffer;
+                    } else {
+                        result += c;
+                    }
+            }
+        }
+        result += '"';
+        return result;
+    }
+
+    std::string lowerCase(std::string value) {
+        std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+        return value;
+    }
+
+    std::vector<std::string> tokenize(const std::string& line) {
+        std::vector<std::string> tokens;
+        std::string token;
+        bool inToken = false;
+        bool quoted = false;
+
+        for (const char c : line) {
+            if (c == '"') {
+                quoted = !quoted;
+                inToken = true;
+            } else if (!quoted && std::isspace(static_cast<unsigned char>(c))) {
+                if (inToken) {
+                    tokens.push_back(std::move(token));
+                    token.clear();
+                    inToken = false;
+                }
+            } else {
+                token += c;
+                inToken = true;
+            }
+        }
+        if (inToken) {
+            tokens.push_back(std::move(token));
+        }
+        return tokens;
+    }
+
+    std::string toJson(const Contact& contact) {
+        const Date birthDate = contact.getBirthDate();
+        std::string birthDateText;
+        if (birthDate.day != 0) {
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", birthDate.year, birthDate.month, birthDate.day);
+            birthDateText = buffer;
+        }
+
+        std::string json = "{\"id\":" + std::to_string(contact.getId()) +
+                           ",\"surname\":" + jsonString(contact.getSurname()) +
+                           ",\"forename\":" + jsonString(contact.getForename()) +
+                           ",\"patronymic\":" + jsonString(contact.getPatronymic()) +
+                           ",\"address\":" + jsonString(contact.getAddress()) +
+                           ",\"birthDate\":" + jsonString(birthDateText) +
+                           ",\"email\":" + jsonString(contact.getEmail()) + ",\"phones\":[";
+
+        const auto& phones = contact.getPhoneNumbers();
+        for (size_t i = 0; i < phones.size(); ++i) {
+            json += (i == 0 ? "{\"type\":" : ",{\"type\":") + jsonString(phones[i].type) +
+                    ",\"number\":" + jsonString(phones[i].number) + "}";
+        }
+        json += "]}";
+        return json;
+    }
+
+    bool parseOptions(const int argc, char* argv[], const int firstArgument, Options& options, std::string& error) {
+        int i = firstArgument;
+        for (; i < argc; ++i) {
+            const std::string argument = argv[i];
+            if (argument == "--storage" || argument == "--file" || argument == "--script") {
+                if (i + 1 >= argc) {
+                    error = "Missing value for " + argument + ".";
+                    return false;
+                }
+                const std::string value = argv[++i];
+                if (argument == "--storage") {
+                    options.storage = value;
+                } else if (argument == "--file") {
+                    options.path = value;
+                } else {
+                    options.script = value;
+                }
+            } else {
+                break;
+            }
+        }
+
+        for (; i < argc; ++i) {
+            options.command.emplace_back(argv[i]);
+        }
+
+        if (options.script.empty() == options.command.empty()) {
+            error = "Specify either a script or a single command.";
+            return false;
+        }
+        return true;
+    }
+
+    std::unique_ptr<ContactStorage> openStorage(const Options& options, std::string& error) {
+        if (options.storage == "file" || options.storage == "journal") {
+            auto storage = std::make_unique<FileStorage>(options.path.empty() ? "contacts.txt" : options.path);
+            storage->setJournalEnabled(options.storage == "journal");
+            return storage;
+        }
+        if (options.storage == "snapshot") {
+            return std::make_unique<SnapshotStorage>(options.path.empty() ? "contacts.snapshot" : options.path);
+        }
+        if (options.storage == "sqlite") {
+            auto storage = std::make_unique<SqliteStorage>(options.path.empty() ? "contacts.sqlite" : options.path);
+            if (!storage->init()) {
+                error = storage->getLastError();
+                return nullptr;
+            }
+            return storage;
+        }
+        if (options.storage == "db") {
+            auto storage = std::make_unique<DbStorage>("localhost", 5432, "phonebook_db", "postgres", "password");
+            if (!storage->init()) {
+                error = storage->getLastError();
+                return nullptr;
+            }
+            return storage;
+        }
+
+        error = "Unknown storage '" + options.storage + "'.";
+        return nullptr;
+    }
+
+    bool parseId(const std::string& text, int& id) {
+        try {
+            size_t parsed = 0;
+            id = std::stoi(text, &parsed);
+            return parsed == text.size() && id > 0;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    bool runSearch(const Phonebook& phonebook, const std::vector<std::string>& command, std::ostream& out,
+                   std::string& error) {
+        std::map<SearchField, std::string> criteria;
+        for (size_t i = 1; i < command.size(); ++i) {
+            const size_t separator = command[i].find('=');
+            const auto field = separator == std::string::npos
+                                   ? searchFieldsByName.end()
+                                   : searchFieldsByName.find(lowerCase(command[i].substr(0, separator)));
+            if (field == searchFieldsByName.end()) {
+                error = "Invalid search criterion '" + command[i] + "'.";
+                return false;
+            }
+            criteria[field->second] = command[i].substr(separator + 1);
+        }
+
+        const std::vector<Contact> results = phonebook.searchContacts(criteria);
+        for (const Contact& contact : results) {
+            out << toJson(contact) << '\n';
+        }
+        out << "{\"command\":\"search\",\"matches\":" << results.size() << "}" << std::endl;
+        return true;
+    }
+
+    bool runImport(Phonebook& phonebook, const std::string& path, std::ostream& out, std::string& error) {
+        FileStorage source(path);
+        const std::vector<Contact> contacts = source.load();
+        if (!source.getLastError().empty()) {
+            error = source.getLastError();
+            return false;
+        }
+
+        size_t imported = 0;
+        size_t skipped = 0;
+        for (Contact contact : contacts) {
+            bool unique = phonebook.isEmailUnique(contact.getEmail(), 0);
+            for (const PhoneNumber& phone : contact.getPhoneNumbers()) {
+                unique = unique && phonebook.isPhoneNumberUnique(phone.number, 0);
+            }
+
+            if (!unique) {
+                ++skipped;
+                continue;
+            }
+            phonebook.addContact(contact);
+            ++imported;
+        }
+
+        out << "{\"command\":\"import\",\"imported\":" << imported << ",\"skipped\":" << skipped << "}"
+            << std::endl;
+        return true;
+    }
+
+    void runDedupe(const Phonebook& phonebook, std::ostream& out) {
+        std::unordered_map<std::string, std::vector<int>> idsByPerson;
+        for (const Contact& contact : phonebook.getAllContacts()) {
+            const Date birthDate = contact.getBirthDate();
+            const std::string key = lowerCase(contact.getSurname()) + ';' + lowerCase(contact.getForename()) + ';' +
+                                    lowerCase(contact.getPatronymic()) + ';' + std::to_string(birthDate.day) + '.' +
+                                    std::to_string(birthDate.month) + '.' + std::to_string(birthDate.year);
+            idsByPerson[key].push_back(contact.getId());
+        }
+
+        std::vector<std::vector<int>> groups;
+        for (auto& [key, ids] : idsByPerson) {
+            if (ids.size() > 1) {
+                groups.push_back(std::move(ids));
+            }
+        }
+        std::sort(groups.begin(), groups.end());
+
+        for (const auto& ids : groups) {
+            out << "{\"duplicates\":[";
+            for (size_t i = 0; i < ids.size(); ++i) {
+                out << (i == 0 ? "" : ",") << ids[i];
+            }
+            out << "]}\n";
+        }
+        out << "{\"command\":\"dedupe\",\"groups\":" << groups.size() << "}" << std::endl;
+    }
+
+    bool executeCommand(Phonebook& phonebook, const std::vector<std::string>& command, std::ostream& out,
+                        std::string& error) {
+        const std::string name = command.front();
+
+        if (name == "count" && command.size() == 1) {
+            out << "{\"command\":\"count\",\"contacts\":" << phonebook.getAllContacts().size() << "}" << std::endl;
+            return true;
+        }
+        if (name == "list" && command.size() == 1) {
+            for (const Contact& contact : phonebook.getAllContacts()) {
+                out << toJson(contact) << '\n';
+            }
+            out << "{\"command\":\"list\",\"contacts\":" << phonebook.getAllContacts().size() << "}" << std::endl;
+            return true;
+        }
+        if (name == "search") {
+            return runSearch(phonebook, command, out, error);
+        }
+        if (name == "import" && command.size() == 2) {
+            return runImport(phonebook, command[1], out, error);
+        }
+        if (name == "export" && command.size() == 2) {
+            FileStorage target(command[1]);
+            if (!target.save(phonebook.getAllContacts())) {
+                error = target.getLastError();
+                return false;
+            }
+            out << "{\"command\":\"export\",\"contacts\":" << phonebook.getAllContacts().size() << "}" << std::endl;
+            return true;
+        }
+        if (name == "dedupe" && command.size() == 1) {
+            runDedupe(phonebook, out);
+            return true;
+        }
+        if (name == "delete" && command.size() == 2) {
+            int id;
+            if (!parseId(command[1], id)) {
+                error = "Invalid ID '" + command[1] + "'.";
+                return false;
+            }
+            const bool deleted = phonebook.deleteContact(id);
+            out << "{\"command\":\"delete\",\"id\":" << id << ",\"deleted\":" << (deleted ? "true" : "false") << "}"
+                << std::endl;
+            return true;
+        }
+
+        error = "Unknown command or wrong number of arguments.";
+        return false;
+    }
+}
+
+namespace batch {
+    bool isBatchInvocation(const int argc, char* argv[]) {
+        return argc > 1 && std::string(argv[1]) == "--batch";
+    }
+
+    int run(int argc, char* argv[], const int firstArgument) {
+        Options options;
+        std::string error;
+        if (!parseOptions(argc, argv, firstArgument, options, error)) {
+            std::cerr << error << std::endl;
+            printUsage(std::cerr);
+            return 2;
+        }
+
+        std::unique_ptr<QCoreApplication> app;
+        if (options.storage == "sqlite" || options.storage == "db") {
+            app = std::make_unique<QCoreApplication>(argc, argv);
+        }
+
+        const std::unique_ptr<ContactStorage> storage = openStorage(options, error);
+        if (storage == nullptr) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+
+        Phonebook phonebook;
+        if (!phonebook.loadFrom(*storage)) {
+            std::cerr << storage->getLastError() << std::endl;
+            return 1;
+        }
+
+        std::vector<std::vector<std::string>> commands;
+        if (!options.command.empty()) {
+            commands.push_back(options.command);
+        } else {
+            std::ifstream scriptFile;
+            if (options.script != "-") {
+                scriptFile.open(options.script);
+                if (!scriptFile.is_open()) {
+                    std::cerr << "Cannot open script '" << options.script << "'." << std::endl;
+                    return 1;
+                }
+            }
+            std::istream& script = options.script == "-" ? std::cin : scriptFile;
+
+            std::string line;
+            while (std::getline(script, line)) {
+                std::vector<std::string> command = tokenize(line);
+                if (!command.empty() && (command.front().empty() || command.front().front() != '#')) {
+                    commands.push_back(std::move(command));
+                }
+            }
+        }
+
+        for (const auto& command : commands) {
+            if (!executeCommand(phonebook, command, std::cout, error)) {
+                std::cout.flush();
+                std::cerr << command.front() << ": " << error << std::endl;
+                return 1;
+            }
+        }
+
+        if (phonebook.hasChanges()) {
+            if (!storage->saveChanges(phonebook.getAllContacts(), phonebook.getChanges())) {
+                std::cerr << "Save error: " << storage->getLastError() << std::endl;
+                return 1;
+            }
+            phonebook.markSaved();
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+namespace batch {
+    bool isBatchInvocation(int argc, char* argv[]);
+    int run(int argc, char* argv[], int firstArgument = 2);
+}
@@ -0,0 +1,5 @@
+#include "batch.h"
+
+int main(int argc, char *argv[]) {
+    return batch::run(argc, argv, 1);
+}
@@ -0,0 +1,18 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    contact_access \
+    db_bulk \
+    parallel_sort \
+    phonebook \
+    sqlite_storage \
+    storage \
+    validation
+
+contact_access.file = bench_contact_access.pro
+db_bulk.file = bench_db_bulk.pro
+parallel_sort.file = bench_parallel_sort.pro
+phonebook.file = bench_phonebook.pro
+sqlite_storage.file = bench_sqlite_storage.pro
+storage.file = bench_storage.pro
+validation.file = bench_validation.pro
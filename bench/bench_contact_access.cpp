@@ -0,0 +1,86 @@
+#include "Phonebook.h"
+#include "benchutil.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+    std::atomic<long long> allocationCount{0};
+
+    long long allocationsDuring(const auto& work) {
+        const long long before = allocationCount.load();
+        work();
+        return allocationCount.load() - before;
+    }
+}
+
+void* operator new(const std::size_t size) {
+    ++allocationCount;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+int main(int argc, char* argv[]) {
+    const int contactCount = argc > 1 ? std::stoi(argv[1]) : 200000;
+
+    Phonebook phonebook;
+    phonebook.reserve(contactCount);
+    for (int i = 0; i < contactCount; ++i) {
+        phonebook.addContactFromStorage(benchutil::makeRealisticContact(i));
+    }
+    phonebook.initializeNextId();
+
+    const double estimatedCompares = contactCount * std::log2(static_cast<double>(contactCount));
+    std::cout << "Contacts: " << contactCount << ", ~" << static_cast<long long>(estimatedCompares)
+              << " compares per sort" << std::endl;
+
+    const std::vector<std::vector<SortCriterion>> sorts = {
+        {{SortField::SURNAME, SortDirection::ASCENDING}, {SortField::FORENAME, SortDirection::ASCENDING}},
+        {{SortField::EMAIL, SortDirection::DESCENDING}},
+        {{SortField::ADDRESS, SortDirection::ASCENDING}, {SortField::BIRTH_DATE, SortDirection::ASCENDING}},
+        {{SortField::ID, SortDirection::ASCENDING}}
+    };
+    for (const auto& criteria : sorts) {
+        benchutil::Timer timer;
+        const long long allocations = allocationsDuring([&] { phonebook.sortContacts(criteria); });
+        std::cout << "sort (" << criteria.size() << " key(s)): " << timer.elapsedMs() << " ms, " << allocations
+                  << " allocations, " << allocations / estimatedCompares << " per compare" << std::endl;
+    }
+
+    long long compareAllocations = 0;
+    long long compares = 0;
+    const auto& contacts = phonebook.getAllContacts();
+    compareAllocations = allocationsDuring([&] {
+        for (size_t i = 1; i < contacts.size(); ++i) {
+            compares += contacts[i - 1].getSurname() < contacts[i].getSurname();
+            compares += contacts[i - 1].getPhoneNumbers().size() < contacts[i].getPhoneNumbers().size();
+        }
+    });
+    std::cout << "getter compares: " << compareAllocations << " allocations for " << 2 * (contacts.size() - 1)
+              << " compares" << std::endl;
+
+    const std::map<SearchField, std::string> noMatch = {{SearchField::SURNAME, "Zzz"}};
+    benchutil::Timer searchTimer;
+    const long long searchAllocations = allocationsDuring([&] {
+        if (!phonebook.searchContacts(noMatch).empty()) {
+            std::cerr << "Unexpected match." << std::endl;
+        }
+    });
+    std::cout << "search (no match): " << searchTimer.elapsedMs() << " ms, " << searchAllocations
+              << " allocations for " << contactCount << " contacts scanned" << std::endl;
+    return compares < 0 ? 1 : 0;
+}
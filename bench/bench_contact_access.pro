@@ -0,0 +1,22 @@
+QT -= core gui
+
+TEMPLATE = app
+
+TARGET = bench_contact_access
+
+CONFIG += c++20
+
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+PHONEBOOK_LIBS = phonebook_core
+PHONEBOOK_BUILD_DIR = $$OUT_PWD/..
+include(../phonebook_libs.pri)
+
+SOURCES += \
+    bench_contact_access.cpp
+
+HEADERS += \
+    benchutil.h
@@ -0,0 +1,56 @@
+#include "DbStorage.h"
+#include "benchutil.h"
+#include <QCoreApplication>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    std::string envOr(const char* name, const std::string& fallback) {
+        const char* value = std::getenv(name);
+        return value != nullptr ? value : fallback;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    const int contactCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+
+    DbStorage storage(envOr("PGHOST", "localhost"), std::stoi(envOr("PGPORT", "5432")),
+                      envOr("PGDATABASE", "phonebook_bench"), envOr("PGUSER", "postgres"),
+                      envOr("PGPASSWORD", "password"));
+    if (!storage.init()) {
+        std::cerr << "Cannot connect: " << storage.getLastError() << std::endl;
+        return 1;
+    }
+
+    std::vector<Contact> contacts;
+    contacts.reserve(contactCount);
+    for (int i = 0; i < contactCount; ++i) {
+        contacts.push_back(benchutil::makeContact(i));
+    }
+
+    std::cout << "Full save of " << contactCount << " contacts (one phone each)" << std::endl;
+
+    for (const int batchSize : {1, 100, 500, 2000}) {
+        storage.setBatchSize(batchSize);
+
+        benchutil::Timer timer;
+        if (!storage.save(contacts)) {
+            std::cerr << "Save failed: " << storage.getLastError() << std::endl;
+            return 1;
+        }
+        const double elapsedMs = timer.elapsedMs();
+
+        std::cout << (batchSize == 1 ? std::string("row by row") : "batch " + std::to_string(batchSize)) << ": "
+                  << elapsedMs << " ms, " << contactCount / (elapsedMs / 1000.0) << " contacts/s" << std::endl;
+    }
+
+    if (storage.load().size() != contacts.size()) {
+        std::cerr << "Reload mismatch: " << storage.getLastError() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,23 @@
+QT += core sql
+QT -= gui
+
+TEMPLATE = app
+
+TARGET = bench_db_bulk
+
+CONFIG += c++20
+
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+PHONEBOOK_LIBS = phonebook_sql phonebook_core
+PHONEBOOK_BUILD_DIR = $$OUT_PWD/..
+include(../phonebook_libs.pri)
+
+SOURCES += \
+    bench_db_bulk.cpp
+
+HEADERS += \
+    benchutil.h
@@ -0,0 +1,81 @@
+#include "Phonebook.h"
+#include "sorting.h"
+#include "benchutil.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int RUNS_PER_THREAD_COUNT = 3;
+
+    std::string describe(const std::vector<SortCriterion>& criteria) {
+        static const char* const fieldNames[] = {"id", "surname", "forename", "patronymic", "address", "birth date",
+                                                 "email"};
+        std::string description;
+        for (const SortCriterion& criterion : criteria) {
+            if (!description.empty()) {
+                description += ", ";
+            }
+            description += fieldNames[static_cast<int>(criterion.field)];
+            description += criterion.direction == SortDirection::ASCENDING ? " asc" : " desc";
+        }
+        return description;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int contactCount = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    const size_t maxThreads = argc > 2 ? std::stoul(argv[2]) : sorting::hardwareThreadCount();
+
+    std::vector<Contact> contacts;
+    contacts.reserve(contactCount);
+    for (int i = 0; i < contactCount; ++i) {
+        contacts.push_back(benchutil::makeRealisticContact(i));
+    }
+    std::cout << "Contacts: " << contactCount << ", threads: 1-" << maxThreads << std::endl;
+
+    const std::vector<std::vector<SortCriterion>> sorts = {
+        {{SortField::SURNAME, SortDirection::ASCENDING}, {SortField::FORENAME, SortDirection::ASCENDING}},
+        {{SortField::EMAIL, SortDirection::DESCENDING}},
+        {{SortField::ADDRESS, SortDirection::ASCENDING}, {SortField::BIRTH_DATE, SortDirection::DESCENDING}},
+        {{SortField::BIRTH_DATE, SortDirection::ASCENDING}, {SortField::ID, SortDirection::ASCENDING}}
+    };
+
+    bool consistent = true;
+    for (const auto& criteria : sorts) {
+        std::cout << describe(criteria) << ":" << std::endl;
+        const std::vector<uint32_t> expected = sorting::sortedPermutation(contacts, criteria, 1);
+        double singleThreadMs = 0;
+
+        for (size_t threads = 1; threads <= maxThreads; ++threads) {
+            double bestMs = 0;
+            for (int run = 0; run < RUNS_PER_THREAD_COUNT; ++run) {
+                benchutil::Timer timer;
+                const std::vector<uint32_t> permutation = sorting::sortedPermutation(contacts, criteria, threads);
+                const double elapsedMs = timer.elapsedMs();
+                bestMs = run == 0 ? elapsedMs : std::min(bestMs, elapsedMs);
+                if (permutation != expected) {
+                    std::cerr << "  " << threads << " thread(s) produced a different order." << std::endl;
+                    consistent = false;
+                }
+            }
+            if (threads == 1) {
+                singleThreadMs = bestMs;
+            }
+            std::cout << "  " << threads << " thread(s): " << bestMs << " ms, speedup "
+                      << singleThreadMs / bestMs << "x" << std::endl;
+        }
+    }
+
+    Phonebook phonebook;
+    phonebook.reserve(contactCount);
+    for (Contact& contact : contacts) {
+        phonebook.addContactFromStorage(std::move(contact));
+    }
+    benchutil::Timer timer;
+    phonebook.sortContacts(sorts.front());
+    std::cout << "Phonebook::sortContacts (" << describe(sorts.front()) << ", " << sorting::hardwareThreadCount()
+              << " thread(s)): " << timer.elapsedMs() << " ms" << std::endl;
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+#include "Phonebook.h"
+#include "validation.h"
+#include "benchutil.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace {
+    bool linearEmailUnique(const Phonebook& phonebook, const std::string& email, const int ignoreId) {
+        const std::string normalizedEmail = validation::normalizeEmail(email);
+        const auto& contacts = phonebook.getAllContacts();
+        return std::none_of(contacts.begin(), contacts.end(), [&](const Contact& contact) {
+            return contact.getId() != ignoreId && contact.getEmail() == normalizedEmail;
+        });
+    }
+
+    bool linearPhoneUnique(const Phonebook& phonebook, const std::string& number, const int ignoreId) {
+        const std::string normalizedNumber = validation::normalizePhoneNumber(number);
+        for (const Contact& contact : phonebook.getAllContacts()) {
+            if (contact.getId() == ignoreId) {
+                continue;
+            }
+            for (const PhoneNumber& phone : contact.getPhoneNumbers()) {
+                if (phone.number == normalizedNumber) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    const Contact* linearFind(const Phonebook& phonebook, const int id) {
+        const auto& contacts = phonebook.getAllContacts();
+        const auto it = std::find_if(contacts.begin(), contacts.end(),
+                                     [id](const Contact& c) { return c.getId() == id; });
+        return it != contacts.end() ? &(*it) : nullptr;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int contactCount = argc > 1 ? std::stoi(argv[1]) : 200000;
+    const int lookupCount = argc > 2 ? std::stoi(argv[2]) : 1000;
+
+    Phonebook phonebook;
+    for (int i = 0; i < contactCount; ++i) {
+        phonebook.addContactFromStorage(benchutil::makeContact(i));
+    }
+    phonebook.initializeNextId();
+
+    std::cout << "Contacts: " << contactCount << ", lookups: " << lookupCount << std::endl;
+
+    size_t hits = 0;
+    auto report = [&](const std::string& name, const double linearMs, const double indexedMs) {
+        std::cout << name << ": linear " << linearMs << " ms, indexed " << indexedMs << " ms, speedup x"
+                  << (indexedMs > 0 ? linearMs / indexedMs : 0) << std::endl;
+    };
+
+    {
+        benchutil::Timer linear;
+        for (int i = 0; i < lookupCount; ++i) {
+            hits += linearFind(phonebook, contactCount - i) != nullptr;
+        }
+        const double linearMs = linear.elapsedMs();
+
+        benchutil::Timer indexed;
+        for (int i = 0; i < lookupCount; ++i) {
+            hits += phonebook.findContact(contactCount - i) != nullptr;
+        }
+        report("findContact", linearMs, indexed.elapsedMs());
+    }
+
+    {
+        benchutil::Timer linear;
+        for (int i = 0; i < lookupCount; ++i) {
+            hits += linearEmailUnique(phonebook, "Name" + std::to_string(contactCount - 1 - i) + "@example.com", 0);
+        }
+        const double linearMs = linear.elapsedMs();
+
+        benchutil::Timer indexed;
+        for (int i = 0; i < lookupCount; ++i) {
+            hits += phonebook.isEmailUnique("Name" + std::to_string(contactCount - 1 - i) + "@example.com", 0);
+        }
+        report("isEmailUnique", linearMs, indexed.elapsedMs());
+    }
+
+    {
+        benchutil::Timer linear;
+        for (int i = 0; i < lookupCount; ++i) {
+            hits += linearPhoneUnique(phonebook, benchutil::phoneNumberFor(contactCount - 1 - i), 0);
+        }
+        const double linearMs = linear.elapsedMs();
+
+        benchutil::Timer indexed;
+        for (int i = 0; i < lookupCount; ++i) {
+            hits += phonebook.isPhoneNumberUnique(benchutil::phoneNumberFor(contactCount - 1 - i), 0);
+        }
+        report("isPhoneNumberUnique", linearMs, indexed.elapsedMs());
+    }
+
+    {
+        const std::vector<std::string> queries = {"name12345", "surname427", "ivanov", "9000123", "street 17, 5"};
+        const int searchRounds = 20;
+
+        benchutil::Timer scan;
+        for (int round = 0; round < searchRounds; ++round) {
+            for (const std::string& query : queries) {
+                hits += phonebook.searchAllFields(query).size();
+            }
+        }
+        const double scanMs = scan.elapsedMs();
+
+        benchutil::Timer build;
+        phonebook.setTrigramIndexEnabled(true);
+        std::cout << "Trigram index build: " << build.elapsedMs() << " ms" << std::endl;
+
+        benchutil::Timer indexed;
+        for (int round = 0; round < searchRounds; ++round) {
+            for (const std::string& query : queries) {
+                hits -= phonebook.searchAllFields(query).size();
+            }
+        }
+        report("searchAllFields", scanMs, indexed.elapsedMs());
+    }
+
+    {
+        benchutil::Timer indexed;
+        for (int i = 0; i < lookupCount; ++i) {
+            Contact contact = benchutil::makeContact(contactCount + i);
+            phonebook.addContact(contact);
+            phonebook.deleteContact(contact.getId());
+        }
+        std::cout << "addContact + deleteContact (tail): " << indexed.elapsedMs() << " ms" << std::endl;
+    }
+
+    for (const std::string position : {"front", "middle"}) {
+        const auto& contacts = phonebook.getAllContacts();
+        const size_t firstSlot = position == "front" ? 0 : contacts.size() / 2;
+        std::vector<int> ids;
+        for (size_t slot = firstSlot; slot < contacts.size() && ids.size() < static_cast<size_t>(lookupCount); ++slot) {
+            ids.push_back(contacts[slot].getId());
+        }
+
+        benchutil::Timer timer;
+        for (const int id : ids) {
+            hits += phonebook.deleteContact(id);
+        }
+        hits += phonebook.getAllContacts().size();
+        std::cout << "deleteContact (" << position << "): " << timer.elapsedMs() << " ms" << std::endl;
+    }
+
+    std::cout << "(checksum " << hits << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "FileStorage.h"
+#include "SqliteStorage.h"
+#include "benchutil.h"
+#include <QCoreApplication>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    bool runScenarios(const std::string& name, ContactStorage& storage, std::vector<Contact>& contacts) {
+        benchutil::Timer saveTimer;
+        if (!storage.save(contacts)) {
+            std::cerr << name << " full save failed: " << storage.getLastError() << std::endl;
+            return false;
+        }
+        const double fullSaveMs = saveTimer.elapsedMs();
+
+        benchutil::Timer loadTimer;
+        const std::vector<Contact> loaded = storage.load();
+        const double loadMs = loadTimer.elapsedMs();
+        if (loaded.size() != contacts.size()) {
+            std::cerr << name << " reload mismatch: " << storage.getLastError() << std::endl;
+            return false;
+        }
+
+        Contact& edited = contacts[contacts.size() / 2];
+        edited.setAddress("Edited street " + std::to_string(edited.getId()));
+
+        ContactChanges changes;
+        changes.fullRewrite = false;
+        changes.upserted.push_back(edited);
+
+        benchutil::Timer editTimer;
+        if (!storage.saveChanges(contacts, changes)) {
+            std::cerr << name << " single-edit save failed: " << storage.getLastError() << std::endl;
+            return false;
+        }
+        const double editSaveMs = editTimer.elapsedMs();
+
+        std::cout << name << ": load " << loadMs << " ms, single-edit save " << editSaveMs
+                  << " ms, full save " << fullSaveMs << " ms" << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    const int contactCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+
+    std::vector<Contact> contacts;
+    contacts.reserve(contactCount);
+    for (int i = 0; i < contactCount; ++i) {
+        contacts.push_back(benchutil::makeContact(i));
+    }
+
+    std::cout << contactCount << " contacts (one phone each)" << std::endl;
+
+    std::remove("bench_contacts.txt");
+    FileStorage fileStorage("bench_contacts.txt");
+    if (!runScenarios("text file", fileStorage, contacts)) {
+        return 1;
+    }
+
+    std::remove("bench_contacts_journal.txt");
+    FileStorage journalStorage("bench_contacts_journal.txt");
+    journalStorage.setJournalEnabled(true);
+    if (!runScenarios("text file with journal", journalStorage, contacts)) {
+        return 1;
+    }
+
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::remove((std::string("bench_contacts.sqlite") + suffix).c_str());
+    }
+    SqliteStorage sqliteStorage("bench_contacts.sqlite");
+    if (!sqliteStorage.init()) {
+        std::cerr << "Cannot open SQLite database: " << sqliteStorage.getLastError() << std::endl;
+        return 1;
+    }
+    if (!runScenarios("SQLite (WAL)", sqliteStorage, contacts)) {
+        return 1;
+    }
+    return 0;
+}
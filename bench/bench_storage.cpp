@@ -0,0 +1,186 @@
+#include "DbStorage.h"
+#include "FileStorage.h"
+#include "SnapshotStorage.h"
+#include "SqliteStorage.h"
+#include "validation.h"
+#include "benchutil.h"
+#include <QCoreApplication>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    struct Backend {
+        std::string name;
+        std::unique_ptr<ContactStorage> storage;
+    };
+
+    std::string envOr(const char* name, const std::string& fallback) {
+        const char* value = std::getenv(name);
+        return value != nullptr ? value : fallback;
+    }
+
+    double percentile(std::vector<double> samples, const double fraction) {
+        std::sort(samples.begin(), samples.end());
+        const size_t rank = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(rank, samples.size() - 1)];
+    }
+
+    void report(const std::string& operation, const std::vector<double>& samplesMs, const double unitsPerRun,
+                const std::string& unit) {
+        const double medianMs = percentile(samplesMs, 0.5);
+        std::cout << "  " << operation << ": " << unitsPerRun / (medianMs / 1000.0) << " " << unit << "/s, p50 "
+                  << medianMs << " ms, p90 " << percentile(samplesMs, 0.9) << " ms, p99 "
+                  << percentile(samplesMs, 0.99) << " ms (" << samplesMs.size() << " runs)" << std::endl;
+    }
+
+    bool validateDataset(const std::vector<Contact>& contacts) {
+        std::unordered_set<std::string> emails;
+        std::unordered_set<std::string> phones;
+
+        for (const Contact& contact : contacts) {
+            const bool valid = validation::isValidName(contact.getSurname()) &&
+                               validation::isValidName(contact.getForename()) &&
+                               (contact.getPatronymic().empty() || validation::isValidName(contact.getPatronymic())) &&
+                               validation::isValidEmail(contact.getEmail()) &&
+                               validation::isForenameInEmail(contact.getEmail(), contact.getForename()) &&
+                               emails.insert(contact.getEmail()).second;
+            if (!valid) {
+                std::cerr << "Generated contact " << contact.getId() << " is invalid." << std::endl;
+                return false;
+            }
+
+            for (const PhoneNumber& phone : contact.getPhoneNumbers()) {
+                if (!validation::isValidPhoneNumber(phone.number) ||
+                    !phones.insert(validation::normalizePhoneNumber(phone.number)).second) {
+                    std::cerr << "Generated phone " << phone.number << " is invalid or duplicated." << std::endl;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool runBackend(Backend& backend, std::vector<Contact>& contacts, const int runs) {
+        ContactStorage& storage = *backend.storage;
+        const double count = static_cast<double>(contacts.size());
+
+        benchutil::resetPeakRss();
+        std::cout << backend.name << std::endl;
+
+        std::vector<double> fullSaveMs;
+        for (int run = 0; run < runs; ++run) {
+            benchutil::Timer timer;
+            if (!storage.save(contacts)) {
+                std::cerr << "  full save failed: " << storage.getLastError() << std::endl;
+                return false;
+            }
+            fullSaveMs.push_back(timer.elapsedMs());
+        }
+        report("full save", fullSaveMs, count, "contacts");
+
+        std::vector<double> loadMs;
+        for (int run = 0; run < runs; ++run) {
+            benchutil::Timer timer;
+            const std::vector<Contact> loaded = storage.load();
+            loadMs.push_back(timer.elapsedMs());
+
+            if (loaded.size() != contacts.size()) {
+                std::cerr << "  load returned " << loaded.size() << " contacts: " << storage.getLastError()
+                          << std::endl;
+                return false;
+            }
+        }
+        report("load", loadMs, count, "contacts");
+
+        std::vector<double> editSaveMs;
+        for (int run = 0; run < runs; ++run) {
+            Contact& edited = contacts[(static_cast<size_t>(run) * 7919) % contacts.size()];
+            edited.setAddress("Edited st. " + std::to_string(run + 1));
+
+            ContactChanges changes;
+            changes.fullRewrite = false;
+            changes.upserted.push_back(edited);
+
+            benchutil::Timer timer;
+            if (!storage.saveChanges(contacts, changes)) {
+                std::cerr << "  single-edit save failed: " << storage.getLastError() << std::endl;
+                return false;
+            }
+            editSaveMs.push_back(timer.elapsedMs());
+        }
+        report("single-edit save", editSaveMs, 1, "edits");
+
+        std::cout << "  peak RSS: " << benchutil::peakRssKb() / 1024 << " MB" << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::stoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 100000, 1000000};
+    }
+
+    for (const char* path : {"bench_storage.txt", "bench_storage.txt.journal", "bench_storage_journal.txt",
+                             "bench_storage_journal.txt.journal", "bench_storage.snapshot", "bench_storage.sqlite",
+                             "bench_storage.sqlite-wal", "bench_storage.sqlite-shm"}) {
+        std::remove(path);
+    }
+
+    std::vector<Backend> backends;
+    backends.push_back({"text file", std::make_unique<FileStorage>("bench_storage.txt")});
+
+    auto journalStorage = std::make_unique<FileStorage>("bench_storage_journal.txt");
+    journalStorage->setJournalEnabled(true);
+    backends.push_back({"text file with journal", std::move(journalStorage)});
+
+    backends.push_back({"binary snapshot", std::make_unique<SnapshotStorage>("bench_storage.snapshot")});
+
+    auto sqliteStorage = std::make_unique<SqliteStorage>("bench_storage.sqlite");
+    if (sqliteStorage->init()) {
+        backends.push_back({"SQLite", std::move(sqliteStorage)});
+    } else {
+        std::cerr << "Skipping SQLite: " << sqliteStorage->getLastError() << std::endl;
+    }
+
+    auto dbStorage = std::make_unique<DbStorage>(envOr("PGHOST", "localhost"), std::stoi(envOr("PGPORT", "5432")),
+                                                 envOr("PGDATABASE", "phonebook_bench"),
+                                                 envOr("PGUSER", "postgres"), envOr("PGPASSWORD", "password"));
+    if (dbStorage->init()) {
+        backends.push_back({"PostgreSQL", std::move(dbStorage)});
+    } else {
+        std::cerr << "Skipping PostgreSQL: " << dbStorage->getLastError() << std::endl;
+    }
+
+    for (const int size : sizes) {
+        std::vector<Contact> contacts;
+        contacts.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            contacts.push_back(benchutil::makeRealisticContact(i));
+        }
+        if (!validateDataset(contacts)) {
+            return 1;
+        }
+
+        const int runs = std::clamp(2000000 / std::max(1, size), 3, 20);
+        std::cout << "\n=== " << size << " contacts, " << runs << " runs per operation ===" << std::endl;
+
+        for (Backend& backend : backends) {
+            if (!runBackend(backend, contacts, runs)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
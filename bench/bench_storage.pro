@@ -0,0 +1,25 @@
+QT += core sql
+QT -= gui
+
+TEMPLATE = app
+
+TARGET = bench_storage
+
+CONFIG += c++20
+
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+PHONEBOOK_LIBS = phonebook_sql phonebook_core
+PHONEBOOK_BUILD_DIR = $$OUT_PWD/..
+include(../phonebook_libs.pri)
+
+win32: LIBS += -lpsapi
+
+SOURCES += \
+    bench_storage.cpp
+
+HEADERS += \
+    benchutil.h
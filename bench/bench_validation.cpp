@@ -0,0 +1,123 @@
+#include "validation.h"
+#include "benchutil.h"
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+    bool legacyIsValidName(const std::string& name) {
+        const std::regex nameRegex("^[a-zA-Z]([a-zA-Z0-9- ]*[a-zA-Z0-9])?$");
+        return std::regex_match(name, nameRegex);
+    }
+
+    bool legacyIsValidEmail(const std::string& email) {
+        const std::regex emailRegex("^[a-zA-Z0-9_.-]+@[a-zA-Z0-9-]+\\.[a-zA-Z]{2,}$");
+        return std::regex_match(email, emailRegex);
+    }
+
+    bool legacyIsValidPhoneNumber(const std::string& phone) {
+        const std::regex phoneRegex(R"(^(\+7|8) ?\(?\d{3}\)? ?\d{3}(-?\d{2}){2}$)");
+        return std::regex_match(phone, phoneRegex);
+    }
+
+    std::vector<std::string> buildCorpus(const size_t size) {
+        const std::vector<std::string> seeds = {
+            "Ivanov", "Anna-Maria", "Van der Berg", "O1", "a", "Smith ", "-Petrov", "Li9",
+            "ivan@example.com", "john.doe_1@mail-box.org", "x@y.z", "a@b.cd", "bad@@mail.com", "no-at.com",
+            "+7 (912) 345-67-89", "8 912 345 67 89", "89123456789", "+7(912)3456789", "+7 912-345-6789",
+            "8 (912) 345-67-8", "+8 (912) 345-67-89", ""
+        };
+        const std::string alphabet = "aZ09 -_.@+()|;:\t\xC3\xA9";
+
+        std::mt19937 rng(42);
+        std::vector<std::string> corpus;
+        corpus.reserve(size);
+
+        for (size_t i = 0; i < size; ++i) {
+            std::string value = seeds[rng() % seeds.size()];
+            const unsigned mutations = rng() % 3;
+            for (unsigned m = 0; m < mutations; ++m) {
+                const char c = alphabet[rng() % alphabet.size()];
+                const size_t pos = value.empty() ? 0 : rng() % (value.size() + 1);
+                switch (rng() % 3) {
+                    case 0:
+                        value.insert(value.begin() + static_cast<std::ptrdiff_t>(pos), c);
+                        break;
+                    case 1:
+                        if (pos < value.size()) {
+                            value.erase(pos, 1);
+                        }
+                        break;
+                    default:
+                        if (pos < value.size()) {
+                            value[pos] = c;
+                        }
+                        break;
+                }
+            }
+            corpus.push_back(value);
+        }
+        return corpus;
+    }
+
+    template<typename Validator>
+    std::vector<char> run(const std::string& name, const std::vector<std::string>& corpus, const size_t count,
+                          Validator validator) {
+        std::vector<char> results;
+        results.reserve(count);
+
+        benchutil::Timer timer;
+        for (size_t i = 0; i < count; ++i) {
+            results.push_back(validator(corpus[i]));
+        }
+        const double elapsedMs = timer.elapsedMs();
+
+        std::cout << "  " << name << ": " << elapsedMs << " ms (" << elapsedMs * 1e6 / static_cast<double>(count)
+                  << " ns/string)" << std::endl;
+        return results;
+    }
+
+    template<typename Legacy, typename Compiled, typename HandWritten>
+    size_t compare(const std::string& title, const std::vector<std::string>& corpus, const size_t legacyCount,
+                   Legacy legacy, Compiled compiled, HandWritten handWritten) {
+        std::cout << title << ":" << std::endl;
+        const std::vector<char> legacyResults = run("regex per call", corpus, legacyCount, legacy);
+        const std::vector<char> compiledResults = run("precompiled regex", corpus, corpus.size(), compiled);
+        const std::vector<char> handResults = run("hand-written", corpus, corpus.size(), handWritten);
+
+        size_t mismatches = 0;
+        size_t accepted = 0;
+        for (size_t i = 0; i < corpus.size(); ++i) {
+            mismatches += compiledResults[i] != handResults[i];
+            mismatches += i < legacyCount && legacyResults[i] != handResults[i];
+            accepted += handResults[i];
+        }
+        std::cout << "  accepted " << accepted << " of " << corpus.size() << ", mismatches: " << mismatches
+                  << std::endl;
+        return mismatches;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const size_t corpusSize = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const size_t legacyCount = std::min(corpusSize, argc > 2 ? std::stoul(argv[2]) : 100000);
+
+    const std::vector<std::string> corpus = buildCorpus(corpusSize);
+    std::cout << "Corpus: " << corpus.size() << " strings (regex per call on first " << legacyCount << ")"
+              << std::endl;
+
+    size_t mismatches = 0;
+    mismatches += compare("isValidName", corpus, legacyCount, legacyIsValidName,
+                          validation::isValidNameRegex,
+                          [](const std::string& value) { return validation::isValidName(value); });
+    mismatches += compare("isValidEmail", corpus, legacyCount, legacyIsValidEmail,
+                          validation::isValidEmailRegex,
+                          [](const std::string& value) { return validation::isValidEmail(value); });
+    mismatches += compare("isValidPhoneNumber", corpus, legacyCount, legacyIsValidPhoneNumber,
+                          validation::isValidPhoneNumberRegex,
+                          [](const std::string& value) { return validation::isValidPhoneNumber(value); });
+
+    return mismatches == 0 ? 0 : 1;
+}
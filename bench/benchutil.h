@@ -0,0 +1,136 @@
+#pragma once
+#include "Contact.h"
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace benchutil {
+    inline std::string phoneNumberFor(const long long index) {
+        char buffer[32];
+        const long long digits = 9000000000LL + index;
+        std::snprintf(buffer, sizeof(buffer), "+7 (%03lld) %03lld-%02lld-%02lld",
+                      digits / 10000000, digits / 10000 % 1000, digits / 100 % 100, digits % 100);
+        return buffer;
+    }
+
+    inline Contact makeContact(const int index) {
+        Contact contact;
+        contact.setId(index + 1);
+        contact.setSurname("Surname" + std::to_string(index % 1000));
+        contact.setForename("Name" + std::to_string(index));
+        contact.setAddress("Street " + std::to_string(index % 500) + ", " + std::to_string(index % 97));
+        contact.setBirthDate(Date(1 + index % 28, 1 + index % 12, 1950 + index % 60));
+        contact.setEmail("name" + std::to_string(index) + "@example.com");
+        contact.addPhoneNumber("mobile", phoneNumberFor(index));
+        return contact;
+    }
+
+    inline uint64_t mix(uint64_t value) {
+        value += 0x9E3779B97F4A7C15ULL;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    inline Contact makeRealisticContact(const int index) {
+        static const char* const surnames[] = {"Ivanov", "Smirnov", "Kuznetsov", "Popov", "Vasiliev", "Petrov",
+            "Sokolov", "Mikhailov", "Novikov", "Fedorov", "Morozov", "Volkov", "Alekseev", "Lebedev", "Semenov"};
+        static const char* const forenames[] = {"Alexander", "Dmitry", "Maxim", "Sergey", "Andrey", "Alexey",
+            "Artem", "Ilya", "Kirill", "Mikhail", "Anna", "Maria", "Elena", "Olga", "Natalia", "Irina"};
+        static const char* const patronymics[] = {"Alexandrovich", "Dmitrievich", "Sergeevich", "Andreevich",
+            "Ivanovna", "Petrovna", "Mikhailovna", "Nikolaevna"};
+        static const char* const streets[] = {"Lenina", "Pushkina", "Gagarina", "Mira", "Sadovaya", "Tverskaya"};
+        static const char* const domains[] = {"example.com", "mail.ru", "yandex.ru", "gmail.com"};
+        static const char* const phoneTypes[] = {"mobile", "home", "work"};
+
+        uint64_t random = mix(static_cast<uint64_t>(index));
+        const auto pick = [&random](const uint64_t count) {
+            const uint64_t value = random % count;
+            random = mix(random);
+            return value;
+        };
+
+        Contact contact;
+        contact.setId(index + 1);
+        contact.setSurname(surnames[pick(std::size(surnames))]);
+
+        const std::string forename = forenames[pick(std::size(forenames))];
+        contact.setForename(forename);
+        if (pick(4) != 0) {
+            contact.setPatronymic(patronymics[pick(std::size(patronymics))]);
+        }
+        if (pick(5) != 0) {
+            contact.setAddress(std::string(streets[pick(std::size(streets))]) + " st. " + std::to_string(1 + pick(200)) +
+                               ", apt. " + std::to_string(1 + pick(300)));
+        }
+        if (pick(3) != 0) {
+            contact.setBirthDate(Date(1 + static_cast<int>(pick(28)), 1 + static_cast<int>(pick(12)),
+                                      1940 + static_cast<int>(pick(70))));
+        }
+
+        std::string email = forename + "." + std::to_string(index) + "@" + domains[pick(std::size(domains))];
+        for (char& c : email) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        contact.setEmail(email);
+
+        const int phoneCount = 1 + static_cast<int>(pick(3));
+        for (int phone = 0; phone < phoneCount; ++phone) {
+            contact.addPhoneNumber(phoneTypes[phone], phoneNumberFor(static_cast<long long>(index) * 3 + phone));
+        }
+        return contact;
+    }
+
+    inline long long peakRssKb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+        }
+        return 0;
+#else
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::stoll(line.substr(6));
+            }
+        }
+
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+    inline void resetPeakRss() {
+#ifdef __linux__
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+#endif
+    }
+
+    class Timer {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    public:
+        double elapsedMs() const {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+}
@@ -3,6 +3,28 @@
 #include <iomanip>
 #include <map>
 
+namespace {
+    bool isEmailUnique(const Phonebook& phonebook, ContactPager* pager, const std::string& email,
+                       const int ignoreId, bool& unique) {
+        unique = phonebook.isEmailUnique(email, ignoreId);
+        if (unique && pager != nullptr && !pager->isEmailUnique(email, ignoreId, unique)) {
+            std::cout << "Could not check the email: " << pager->getLastError() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool isPhoneNumberUnique(const Phonebook& phonebook, ContactPager* pager, const std::string& number,
+                             const int ignoreId, bool& unique) {
+        unique = phonebook.isPhoneNumberUnique(number, ignoreId);
+        if (unique && pager != nullptr && !pager->isPhoneNumberUnique(number, ignoreId, unique)) {
+            std::cout << "Could not check the phone number: " << pager->getLastError() << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
 namespace cli {
     void displayMenu() {
         std::cout << "\n--- Phonebook ---" << std::endl;
@@ -21,10 +43,10 @@ namespace cli {
         std::cout << "Surname: " << contact.getSurname() << std::endl;
         std::cout << "Forename: " << contact.getForename() << std::endl;
 
-        const std::string patronymic = contact.getPatronymic();
+        const std::string& patronymic = contact.getPatronymic();
         std::cout << "Patronymic: " << (patronymic.empty() ? "(not specified)" : patronymic) << std::endl;
 
-        const std::string address = contact.getAddress();
+        const std::string& address = contact.getAddress();
         std::cout << "Address: " << (address.empty() ? "(not specified)" : address) << std::endl;
 
         std::cout << "Birth date: ";
@@ -58,8 +80,37 @@ namespace cli {
         }
     }
 
-    std::vector<Contact> searchContacts(const Phonebook& phonebook) {
-        if (phonebook.getAllContacts().empty()) {
+    void printAllContacts(const Phonebook& phonebook, ContactPager& pager) {
+        std::vector<Contact> page;
+        if (phonebook.getAllContacts().empty() && !pager.fetchNextPage(page)) {
+            std::cout << "\nLoad error: " << pager.getLastError() << std::endl;
+            return;
+        }
+
+        printAllContacts(phonebook);
+
+        while (!pager.isExhausted()) {
+            const char choice = getInput<char>("\nLoad next page? (Y/n): ");
+            if (choice == 'N' || choice == 'n') {
+                break;
+            }
+            if (choice != 'Y' && choice != 'y') {
+                std::cout << "Invalid input." << std::endl;
+                continue;
+            }
+
+            if (!pager.fetchNextPage(page)) {
+                std::cout << "Load error: " << pager.getLastError() << std::endl;
+                break;
+            }
+            for (const Contact& contact : page) {
+                printContact(contact);
+            }
+        }
+    }
+
+    std::vector<Contact> searchContacts(const Phonebook& phonebook, ContactPager* pager) {
+        if (pager == nullptr && phonebook.getAllContacts().empty()) {
             std::cout << "\nPhonebook is empty." << std::endl;
             return {};
         }
@@ -130,7 +181,15 @@ namespace cli {
             criteria.insert({SearchField::PHONE, query});
         }
 
-        std::vector<Contact> foundContacts = phonebook.searchContacts(criteria);
+        std::vector<Contact> foundContacts;
+        if (pager != nullptr) {
+            if (!pager->search(criteria, foundContacts)) {
+                std::cout << "\nSearch error: " << pager->getLastError() << std::endl;
+                return {};
+            }
+        } else {
+            foundContacts = phonebook.searchContacts(criteria);
+        }
 
         if (foundContacts.empty()) {
             std::cout << "\nNothing found for the specified criteria." << std::endl;
@@ -195,7 +254,7 @@ namespace cli {
     }
 
     std::string getEmailInput(const std::string& forename, const Phonebook& phonebook,
-                              const int ignoreId)
+                              const int ignoreId, ContactPager* pager)
     {
         std::string input;
         while (true) {
@@ -213,7 +272,11 @@ namespace cli {
                 continue;
             }
 
-            if (phonebook.isEmailUnique(email, ignoreId)) {
+            bool unique;
+            if (!isEmailUnique(phonebook, pager, email, ignoreId, unique)) {
+                return {};
+            }
+            if (unique) {
                 return email;
             }
             std::cout << "This email is already in use." << std::endl;
@@ -233,7 +296,8 @@ namespace cli {
         }
     }
 
-    std::string getPhoneNumberInput(const Phonebook& phonebook, const Contact* currentContact, const int editIdx) {
+    std::string getPhoneNumberInput(const Phonebook& phonebook, const Contact* currentContact, const int editIdx,
+                                    ContactPager* pager) {
         std::string input;
         const int contactId = currentContact ? currentContact->getId() : 0;
 
@@ -247,7 +311,11 @@ namespace cli {
                 continue;
             }
 
-            if (!phonebook.isPhoneNumberUnique(number, contactId)) {
+            bool unique;
+            if (!isPhoneNumberUnique(phonebook, pager, number, contactId, unique)) {
+                return {};
+            }
+            if (!unique) {
                 std::cout << "This phone number is already in use by other contact." << std::endl;
                 continue;
             }
@@ -278,7 +346,7 @@ namespace cli {
         }
     }
 
-    void addContact(Phonebook& phonebook) {
+    void addContact(Phonebook& phonebook, ContactPager* pager) {
         Contact newContact;
 
         std::cout << "\n--- Adding contact ---" << std::endl;
@@ -288,10 +356,19 @@ namespace cli {
         newContact.setPatronymic(getNameInput("Enter patronymic (or press Enter to skip): ", false));
         newContact.setAddress(getAddressInput("Enter address (or press Enter to skip): "));
         newContact.setBirthDate(getBirthDateInput("Enter day of birth (or 0 to skip): "));
-        newContact.setEmail(getEmailInput(newContact.getForename(), phonebook));
+        const std::string email = getEmailInput(newContact.getForename(), phonebook, 0, pager);
+        if (email.empty()) {
+            std::cout << "Contact was not added." << std::endl;
+            return;
+        }
+        newContact.setEmail(email);
 
         std::string type = getPhoneTypeInput();
-        std::string number = getPhoneNumberInput(phonebook, &newContact);
+        std::string number = getPhoneNumberInput(phonebook, &newContact, -1, pager);
+        if (number.empty()) {
+            std::cout << "Contact was not added." << std::endl;
+            return;
+        }
         newContact.addPhoneNumber(type, number);
         std::cout << "First phone number added." << std::endl;
 
@@ -302,7 +379,11 @@ namespace cli {
             }
             if (choice == 'Y' || choice == 'y') {
                 type = getPhoneTypeInput();
-                number = getPhoneNumberInput(phonebook, &newContact);
+                number = getPhoneNumberInput(phonebook, &newContact, -1, pager);
+                if (number.empty()) {
+                    std::cout << "Contact was not added." << std::endl;
+                    return;
+                }
                 newContact.addPhoneNumber(type, number);
                 std::cout << "Another phone number added." << std::endl;
             }
@@ -312,8 +393,8 @@ namespace cli {
         std::cout << "\nContact added." << std::endl;
     }
 
-    void editContact(Phonebook& phonebook) {
-        if (phonebook.getAllContacts().empty()) {
+    void editContact(Phonebook& phonebook, ContactPager* pager) {
+        if (pager == nullptr && phonebook.getAllContacts().empty()) {
             std::cout << "\nPhonebook is empty." << std::endl;
             return;
         }
@@ -321,7 +402,7 @@ namespace cli {
         std::cout << "\n--- Editing contact ---" << std::endl;
         std::cout << "First, find the contact you want to edit." << std::endl;
 
-        const std::vector<Contact> foundContacts = searchContacts(phonebook);
+        const std::vector<Contact> foundContacts = searchContacts(phonebook, pager);
 
         if (foundContacts.empty()) {
             return;
@@ -338,11 +419,11 @@ namespace cli {
 
             if (idx > 0 && idx <= foundContacts.size()) {
                 const int idToEdit = foundContacts[idx - 1].getId();
-                Contact* contactToEdit = phonebook.findContact(idToEdit);
+                Contact contactToEdit = *phonebook.findContact(idToEdit);
 
                 while (true) {
                     std::cout << "\n--- Editing contact ---" << std::endl;
-                    printContact(*contactToEdit);
+                    printContact(contactToEdit);
                     std::cout << " 1. Edit surname" << std::endl;
                     std::cout << " 2. Edit forename" << std::endl;
                     std::cout << " 3. Edit patronymic" << std::endl;
@@ -356,59 +437,80 @@ namespace cli {
                     std::cout << "---------------------------------" << std::endl;
 
                     const char choice = getInput<char>("Your choice: ");
+                    bool modified = false;
 
                     switch (choice) {
                         case '1': {
-                            contactToEdit->setSurname(getNameInput("Enter surname: ", true));
+                            contactToEdit.setSurname(getNameInput("Enter surname: ", true));
                             std::cout << "Surname updated." << std::endl;
+                            modified = true;
                             break;
                         }
                         case '2': {
                             std::string name = getNameInput("Enter forename: ", true);
-                            if (!validation::isForenameInEmail(contactToEdit->getEmail(), name)) {
+                            if (!validation::isForenameInEmail(contactToEdit.getEmail(), name)) {
                                 std::cout << "Current email does not match the forename '" << name << "'." << std::endl;
                                 std::cout << "You must update the email now." << std::endl;
 
-                                std::string email = getEmailInput(name, phonebook, contactToEdit->getId());
-                                contactToEdit->setEmail(email);
+                                std::string email = getEmailInput(name, phonebook, contactToEdit.getId(), pager);
+                                if (email.empty()) {
+                                    std::cout << "Editing aborted." << std::endl;
+                                    return;
+                                }
+                                contactToEdit.setEmail(email);
                                 std::cout << "Email updated." << std::endl;
                             }
-                            contactToEdit->setForename(name);
+                            contactToEdit.setForename(name);
                             std::cout << "Forename updated." << std::endl;
+                            modified = true;
                             break;
                         }
                         case '3': {
-                            contactToEdit->setPatronymic(getNameInput("Enter patronymic: ", false));
+                            contactToEdit.setPatronymic(getNameInput("Enter patronymic: ", false));
                             std::cout << "Patronymic updated." << std::endl;
+                            modified = true;
                             break;
                         }
                         case '4': {
-                            contactToEdit->setAddress(getAddressInput("Enter address (or press Enter "
-                                                                      "to clear): "));
+                            contactToEdit.setAddress(getAddressInput("Enter address (or press Enter "
+                                                                     "to clear): "));
                             std::cout << "Address updated." << std::endl;
+                            modified = true;
                             break;
                         }
                         case '5': {
-                            contactToEdit->setBirthDate(getBirthDateInput("Enter birth day (or 0 "
-                                                                     "to clear): "));
+                            contactToEdit.setBirthDate(getBirthDateInput("Enter birth day (or 0 "
+                                                                    "to clear): "));
                             std::cout << "Birth date updated." << std::endl;
+                            modified = true;
                             break;
                         }
                         case '6': {
-                            contactToEdit->setEmail(
-                                getEmailInput(contactToEdit->getForename(), phonebook, contactToEdit->getId()));
+                            std::string email =
+                                getEmailInput(contactToEdit.getForename(), phonebook, contactToEdit.getId(), pager);
+                            if (email.empty()) {
+                                std::cout << "Editing aborted." << std::endl;
+                                return;
+                            }
+                            contactToEdit.setEmail(email);
                             std::cout << "Email updated." << std::endl;
+                            modified = true;
                             break;
                         }
                         case '7': {
                             std::string type = getPhoneTypeInput();
-                            std::string number = getPhoneNumberInput(phonebook, contactToEdit);
-                            contactToEdit->addPhoneNumber(type, number);
+                            std::string number = getPhoneNumberInput(phonebook, &contactToEdit, -1, pager);
+                            if (number.empty()) {
+                                std::cout << "Editing aborted." << std::endl;
+                                return;
+                            }
+                            contactToEdit.addPhoneNumber(type, number);
                             std::cout << "Phone number added." << std::endl;
+                            modified = true;
                             break;
                         }
                         case '8': {
-                            const std::vector<PhoneNumber>& numbers = contactToEdit->getPhoneNumbers();
+                            const std::vector<PhoneNumber>& numbers = contactToEdit.getPhoneNumbers();
 
                             for (size_t i = 0; i < numbers.size(); ++i) {
                                 std::cout << i + 1 << ". " << numbers[i].type << ": " << numbers[i].number << std::endl;
@@ -424,16 +526,21 @@ namespace cli {
                             if (pIdx > 0 && pIdx <= numbers.size()) {
                                 std::string type = getPhoneTypeInput();
                                 std::string number = getPhoneNumberInput(
-                                    phonebook, contactToEdit, static_cast<int>(pIdx - 1));
-                                contactToEdit->editPhoneNumber(pIdx - 1, type, number);
+                                    phonebook, &contactToEdit, static_cast<int>(pIdx - 1), pager);
+                                if (number.empty()) {
+                                    std::cout << "Editing aborted." << std::endl;
+                                    return;
+                                }
+                                contactToEdit.editPhoneNumber(pIdx - 1, type, number);
                                 std::cout << "Phone number updated." << std::endl;
+                                modified = true;
                                 break;
                             }
                             std::cout << "Invalid input." << std::endl;
                             break;
                         }
                         case '9': {
-                            const std::vector<PhoneNumber>& numbers = contactToEdit->getPhoneNumbers();
+                            const std::vector<PhoneNumber>& numbers = contactToEdit.getPhoneNumbers();
 
                             if (numbers.size() == 1) {
                                 std::cout << "Cannot delete the only phone number." << std::endl;
@@ -452,8 +559,9 @@ namespace cli {
                             }
 
                             if (pIdx > 0 && pIdx <= numbers.size()) {
-                                contactToEdit->deletePhoneNumber(pIdx - 1);
+                                contactToEdit.deletePhoneNumber(pIdx - 1);
                                 std::cout << "Phone number deleted." << std::endl;
+                                modified = true;
                                 break;
                             }
                             std::cout << "Invalid input." << std::endl;
@@ -468,14 +576,18 @@ namespace cli {
                             break;
                         }
                     }
+
+                    if (modified) {
+                        phonebook.updateContact(contactToEdit);
+                    }
                 }
             }
             std::cout << "Invalid index number." << std::endl;
         }
     }
 
-    void deleteContact(Phonebook& phonebook) {
-        if (phonebook.getAllContacts().empty()) {
+    void deleteContact(Phonebook& phonebook, ContactPager* pager) {
+        if (pager == nullptr && phonebook.getAllContacts().empty()) {
             std::cout << "\nPhonebook is empty." << std::endl;
             return;
         }
@@ -483,7 +595,7 @@ namespace cli {
         std::cout << "\n--- Deleting contact ---" << std::endl;
         std::cout << "First, find the contact you want to delete." << std::endl;
 
-        const std::vector<Contact> foundContacts = searchContacts(phonebook);
+        const std::vector<Contact> foundContacts = searchContacts(phonebook, pager);
 
         if (foundContacts.empty()) {
             return;
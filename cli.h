@@ -1,4 +1,5 @@
 #pragma once
+#include "ContactPager.h"
 #include "Phonebook.h"
 #include <iostream>
 #include <limits>
@@ -10,20 +11,22 @@ namespace cli {
 
     void printContact(const Contact& contact);
     void printAllContacts(const Phonebook& phonebook);
+    void printAllContacts(const Phonebook& phonebook, ContactPager& pager);
 
-    std::vector<Contact> searchContacts(const Phonebook& phonebook);
+    std::vector<Contact> searchContacts(const Phonebook& phonebook, ContactPager* pager = nullptr);
 
     std::string getNameInput(const std::string& prompt, bool isMandatory);
     std::string getAddressInput(const std::string& prompt);
     Date getBirthDateInput(const std::string& prompt);
     std::string getEmailInput(const std::string& forename, const Phonebook& phonebook,
-                              int ignoreId = 0);
+                              int ignoreId = 0, ContactPager* pager = nullptr);
     std::string getPhoneTypeInput();
-    std::string getPhoneNumberInput(const Phonebook& phonebook, const Contact* currentContact, int editIdx = -1);
+    std::string getPhoneNumberInput(const Phonebook& phonebook, const Contact* currentContact, int editIdx = -1,
+                                    ContactPager* pager = nullptr);
 
-    void addContact(Phonebook& phonebook);
-    void editContact(Phonebook& phonebook);
-    void deleteContact(Phonebook& phonebook);
+    void addContact(Phonebook& phonebook, ContactPager* pager = nullptr);
+    void editContact(Phonebook& phonebook, ContactPager* pager = nullptr);
+    void deleteContact(Phonebook& phonebook, ContactPager* pager = nullptr);
     void sortContacts(Phonebook& phonebook);
 
     template<typename T> T getInput(const std::string& prompt) {
@@ -0,0 +1,79 @@
+#include "fileio.h"
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+bool fileio::syncFile(std::FILE* file) {
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+void fileio::syncParentDirectory(const std::string& path) {
+#ifndef _WIN32
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    const int fd = open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#endif
+}
+
+bool fileio::writeFileSynced(const std::string& path, const std::function<bool(std::FILE*)>& write,
+                             std::string& error) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "Cannot open file '" + path + "' for writing.";
+        return false;
+    }
+
+    bool written = write(file);
+    written = written && std::fflush(file) == 0 && syncFile(file);
+    written = std::fclose(file) == 0 && written;
+
+    if (!written) {
+        error = "Cannot write file '" + path + "'.";
+        std::remove(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool fileio::replaceFile(const std::string& from, const std::string& to, std::string& error) {
+    std::error_code renameError;
+    std::filesystem::rename(from, to, renameError);
+    if (renameError) {
+        error = "Cannot replace file '" + to + "': " + renameError.message();
+        return false;
+    }
+
+    syncParentDirectory(to);
+    return true;
+}
+
+bool fileio::writeFileAtomically(const std::string& path, const std::function<bool(std::FILE*)>& write,
+                                 std::string& error) {
+    const std::string tempPath = path + ".tmp";
+    if (!writeFileSynced(tempPath, write, error)) {
+        return false;
+    }
+
+    if (!replaceFile(tempPath, path, error)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdio>
+#include <functional>
+#include <string>
+
+namespace fileio {
+    bool syncFile(std::FILE* file);
+    void syncParentDirectory(const std::string& path);
+
+    bool writeFileSynced(const std::string& path, const std::function<bool(std::FILE*)>& write, std::string& error);
+    bool replaceFile(const std::string& from, const std::string& to, std::string& error);
+    bool writeFileAtomically(const std::string& path, const std::function<bool(std::FILE*)>& write,
+                             std::string& error);
+}
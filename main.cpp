@@ -1,12 +1,17 @@
+#include "batch.h"
 #include "cli.h"
+#include "ContactPager.h"
 #include "DbStorage.h"
 #include "FileStorage.h"
+#include "SnapshotStorage.h"
+#include "SqliteStorage.h"
 #include "Phonebook.h"
 
 #include <QApplication>
 #include <QMessageBox>
 #include "MainWindow.h"
 
+#include <filesystem>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -16,6 +21,10 @@
 #endif
 
 int main(int argc, char *argv[]) {
+    if (batch::isBatchInvocation(argc, argv)) {
+        return batch::run(argc, argv);
+    }
+
     QApplication app(argc, argv);
 
 #ifdef _WIN32
@@ -41,23 +50,31 @@ int main(int argc, char *argv[]) {
         std::cout << "\nSelect storage mode:" << std::endl;
         std::cout << "1. File storage (contacts.txt)" << std::endl;
         std::cout << "2. Database storage (PostgreSQL)" << std::endl;
+        std::cout << "3. File storage with change journal (contacts.txt)" << std::endl;
+        std::cout << "4. Binary snapshot storage (contacts.snapshot)" << std::endl;
+        std::cout << "5. Database storage with paged browsing (PostgreSQL)" << std::endl;
+        std::cout << "6. Embedded database storage (contacts.sqlite)" << std::endl;
 
         storageMode = cli::getInput<char>("Your choice: ");
 
-        if (storageMode == '1' || storageMode == '2') {
+        if (storageMode >= '1' && storageMode <= '6') {
             break;
         }
         std::cout << "Invalid choice." << std::endl;
     }
 
     ContactStorage* storage = nullptr;
+    DbStorage* pagedDb = nullptr;
 
-    if (storageMode == '2') {
+    if (storageMode == '2' || storageMode == '5') {
         const auto db = new DbStorage("localhost", 5432, "phonebook_db","postgres", "password");
 
         std::cout << "Connecting to database...\n" << std::endl;
         if (db->init()) {
             storage = db;
+            if (storageMode == '5') {
+                pagedDb = db;
+            }
         } else {
             const std::string errorText = db->getLastError() + "\n\nFalling back to file storage.";
 
@@ -70,31 +87,84 @@ int main(int argc, char *argv[]) {
             delete db;
             storage = new FileStorage("contacts.txt");
         }
+    } else if (storageMode == '3') {
+        const auto file = new FileStorage("contacts.txt");
+        file->setJournalEnabled(true);
+        storage = file;
+        std::cout << "Using file storage with change journal." << std::endl;
+    } else if (storageMode == '4') {
+        if (!std::filesystem::exists("contacts.snapshot") && std::filesystem::exists("contacts.txt")) {
+            std::cout << "Converting contacts.txt to contacts.snapshot..." << std::endl;
+
+            std::string conversionError;
+            if (!SnapshotStorage::convertFromText("contacts.txt", "contacts.snapshot", conversionError)) {
+                const std::string errorText = "Conversion failed: " + conversionError;
+
+                if (interfaceMode == '2') {
+                    QMessageBox::critical(nullptr, "Storage error", QString::fromStdString(errorText));
+                } else {
+                    std::cerr << errorText << std::endl;
+                }
+            }
+        }
+        storage = new SnapshotStorage("contacts.snapshot");
+        std::cout << "Using binary snapshot storage." << std::endl;
+    } else if (storageMode == '6') {
+        const auto sqlite = new SqliteStorage("contacts.sqlite");
+        if (sqlite->init()) {
+            storage = sqlite;
+            std::cout << "Using embedded database storage." << std::endl;
+        } else {
+            const std::string errorText = sqlite->getLastError() + "\n\nFalling back to file storage.";
+
+            if (interfaceMode == '2') {
+                QMessageBox::critical(nullptr, "Storage error", QString::fromStdString(errorText));
+            } else {
+                std::cerr << errorText << std::endl;
+            }
+
+            delete sqlite;
+            storage = new FileStorage("contacts.txt");
+        }
     } else {
         storage = new FileStorage("contacts.txt");
         std::cout << "Using file storage." << std::endl;
     }
 
     Phonebook phonebook;
+    ContactPager* pager = nullptr;
 
-    std::cout << "\nLoading contacts..." << std::endl;
-    const std::vector<Contact> loadedContacts = storage->load();
+    if (pagedDb != nullptr) {
+        pager = new ContactPager(*pagedDb, phonebook);
+        if (pager->start()) {
+            std::cout << "\nContacts will be loaded page by page." << std::endl;
+        } else {
+            const std::string errorText = pager->getLastError() + "\n\nLoading all contacts instead.";
 
-    if (!storage->getLastError().empty()) {
-        const std::string errorText = storage->getLastError();
+            if (interfaceMode == '2') {
+                QMessageBox::critical(nullptr, "Storage error", QString::fromStdString(errorText));
+            } else {
+                std::cerr << errorText << std::endl;
+            }
 
-        if (interfaceMode == '2') {
-            QMessageBox::critical(nullptr, "Storage error", QString::fromStdString(errorText));
-        } else {
-            std::cerr << errorText << std::endl;
+            delete pager;
+            pager = nullptr;
         }
     }
 
-    for (const auto& contact : loadedContacts) {
-        phonebook.addContactFromStorage(contact);
+    if (pager == nullptr) {
+        std::cout << "\nLoading contacts..." << std::endl;
+        if (!phonebook.loadFrom(*storage)) {
+            const std::string errorText = storage->getLastError();
+
+            if (interfaceMode == '2') {
+                QMessageBox::critical(nullptr, "Storage error", QString::fromStdString(errorText));
+            } else {
+                std::cerr << errorText << std::endl;
+            }
+        }
+        std::cout << "Loaded " << phonebook.getAllContacts().size() << " contact(s)." << std::endl;
     }
-    phonebook.initializeNextId();
-    std::cout << "Loaded " << loadedContacts.size() << " contact(s)." << std::endl;
 
     int exitCode = 0;
 
@@ -106,23 +176,27 @@ int main(int argc, char *argv[]) {
             const char menuChoice = cli::getInput<char>("Your choice: ");
             switch (menuChoice) {
                 case '1': {
-                    cli::printAllContacts(phonebook);
+                    if (pager != nullptr) {
+                        cli::printAllContacts(phonebook, *pager);
+                    } else {
+                        cli::printAllContacts(phonebook);
+                    }
                     break;
                 }
                 case '2': {
-                    cli::searchContacts(phonebook);
+                    cli::searchContacts(phonebook, pager);
                     break;
                 }
                 case '3': {
-                    cli::addContact(phonebook);
+                    cli::addContact(phonebook, pager);
                     break;
                 }
                 case '4': {
-                    cli::editContact(phonebook);
+                    cli::editContact(phonebook, pager);
                     break;
                 }
                 case '5': {
-                    cli::deleteContact(phonebook);
+                    cli::deleteContact(phonebook, pager);
                     break;
                 }
                 case '6': {
@@ -149,7 +223,8 @@ int main(int argc, char *argv[]) {
 
             if (saveChoice == 'Y' || saveChoice == 'y') {
                 std::cout << "Saving contacts..." << std::endl;
-                if (storage->save(phonebook.getAllContacts())) {
+                if (storage->saveChanges(phonebook.getAllContacts(), phonebook.getChanges())) {
+                    phonebook.markSaved();
                     std::cout << "Contacts saved." << std::endl;
                 } else {
                     std::cout << "Save error: " << storage->getLastError() << std::endl;
@@ -159,11 +234,15 @@ int main(int argc, char *argv[]) {
             std::cout << "Invalid input." << std::endl;
         }
     } else {
-        MainWindow w(phonebook, storage);
+        phonebook.setTrigramIndexEnabled(true);
+        phonebook.setSortIndexEnabled(true);
+
+        MainWindow w(phonebook, storage, pager);
         w.show();
         exitCode = app.exec();
     }
 
+    delete pager;
     delete storage;
     return exitCode;
 }
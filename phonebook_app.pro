@@ -0,0 +1,35 @@
+QT += core gui sql widgets
+
+TEMPLATE = app
+
+TARGET = phonebook
+
+CONFIG += c++20
+
+CONFIG += console
+
+OBJECTS_DIR = obj/$$TARGET
+MOC_DIR = moc/$$TARGET
+
+PHONEBOOK_LIBS = phonebook_sql phonebook_core
+include(phonebook_libs.pri)
+
+SOURCES += \
+    ContactDialog.cpp \
+    SearchDialog.cpp \
+    SortDialog.cpp \
+    main.cpp \
+    batch.cpp \
+    cli.cpp \
+    MainWindow.cpp
+
+HEADERS += \
+    ContactDialog.h \
+    SearchDialog.h \
+    SortDialog.h \
+    batch.h \
+    cli.h \
+    MainWindow.h
+
+DISTFILES += \
+    contacts.txt
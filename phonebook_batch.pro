@@ -0,0 +1,23 @@
+QT += core sql
+QT -= gui
+
+TEMPLATE = app
+
+TARGET = phonebook_batch
+
+CONFIG += c++20
+
+CONFIG += console
+CONFIG -= app_bundle
+
+OBJECTS_DIR = obj/$$TARGET
+
+PHONEBOOK_LIBS = phonebook_sql phonebook_core
+include(phonebook_libs.pri)
+
+SOURCES += \
+    batch_main.cpp \
+    batch.cpp
+
+HEADERS += \
+    batch.h
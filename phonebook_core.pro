@@ -0,0 +1,38 @@
+QT -= core gui
+
+TEMPLATE = lib
+
+TARGET = phonebook_core
+
+CONFIG += c++20
+CONFIG += staticlib
+
+SOURCES += \
+    Phonebook.cpp \
+    sorting.cpp \
+    SortIndex.cpp \
+    ContactPager.cpp \
+    TrigramIndex.cpp \
+    Contact.cpp \
+    FileStorage.cpp \
+    SnapshotStorage.cpp \
+    fileio.cpp \
+    MappedFile.cpp \
+    validation.cpp
+
+HEADERS += \
+    Phonebook.h \
+    sorting.h \
+    SortCriterion.h \
+    SortIndex.h \
+    ContactPager.h \
+    PagedContactSource.h \
+    TrigramIndex.h \
+    Contact.h \
+    Date.h \
+    FileStorage.h \
+    SnapshotStorage.h \
+    fileio.h \
+    MappedFile.h \
+    validation.h \
+    ContactStorage.h
@@ -0,0 +1,13 @@
+isEmpty(PHONEBOOK_BUILD_DIR): PHONEBOOK_BUILD_DIR = $$OUT_PWD
+
+win32:CONFIG(release, debug|release): PHONEBOOK_LIB_DIR = $$PHONEBOOK_BUILD_DIR/release
+else:win32:CONFIG(debug, debug|release): PHONEBOOK_LIB_DIR = $$PHONEBOOK_BUILD_DIR/debug
+else: PHONEBOOK_LIB_DIR = $$PHONEBOOK_BUILD_DIR
+
+LIBS += -L$$PHONEBOOK_LIB_DIR
+
+for(library, PHONEBOOK_LIBS) {
+    LIBS += -l$$library
+    win32-msvc*: PRE_TARGETDEPS += $$PHONEBOOK_LIB_DIR/$${library}.lib
+    else: PRE_TARGETDEPS += $$PHONEBOOK_LIB_DIR/lib$${library}.a
+}
@@ -0,0 +1,21 @@
+QT += core sql
+QT -= gui
+
+TEMPLATE = lib
+
+TARGET = phonebook_sql
+
+CONFIG += c++20
+CONFIG += staticlib
+
+SOURCES += \
+    ContactRowReader.cpp \
+    ContactRowWriter.cpp \
+    DbStorage.cpp \
+    SqliteStorage.cpp
+
+HEADERS += \
+    ContactRowReader.h \
+    ContactRowWriter.h \
+    DbStorage.h \
+    SqliteStorage.h
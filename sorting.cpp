@@ -0,0 +1,380 @@
+#include "sorting.h"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+    constexpr size_t MAX_STRING_KEY_WORDS = 4;
+    constexpr size_t INLINE_KEY_WORDS = 6;
+    constexpr size_t PARALLEL_SORT_MIN_CONTACTS = 50000;
+
+    using StringGetter = const std::string& (Contact::*)() const;
+
+    struct KeyColumn {
+        bool descending = false;
+        StringGetter getter = nullptr;
+        size_t words = 1;
+        bool exact = true;
+        bool inlined = false;
+        size_t inlineOffset = 0;
+        std::vector<uint64_t> keys;
+        std::vector<uint8_t> lengths;
+    };
+
+    struct SortRecord {
+        std::array<uint64_t, INLINE_KEY_WORDS> words;
+        uint32_t index;
+    };
+
+    template <typename Task>
+    void runTasks(const size_t taskCount, const Task& task) {
+        if (taskCount == 1) {
+            task(0);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(taskCount);
+        for (size_t i = 0; i < taskCount; ++i) {
+            workers.emplace_back([&task, i]() { task(i); });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    template <typename Body>
+    void parallelFor(const size_t count, const size_t threadCount, const Body& body) {
+        runTasks(threadCount, [&](const size_t chunk) {
+            body(count * chunk / threadCount, count * (chunk + 1) / threadCount);
+        });
+    }
+
+    StringGetter stringGetterFor(const SortField field) {
+        switch (field) {
+            case SortField::SURNAME:
+                return &Contact::getSurname;
+            case SortField::FORENAME:
+                return &Contact::getForename;
+            case SortField::PATRONYMIC:
+                return &Contact::getPatronymic;
+            case SortField::ADDRESS:
+                return &Contact::getAddress;
+            case SortField::EMAIL:
+                return &Contact::getEmail;
+            default:
+                return nullptr;
+        }
+    }
+
+    uint64_t packWord(const std::string& value, const size_t offset) {
+        uint64_t word = 0;
+        for (size_t i = offset; i < offset + sizeof(uint64_t); ++i) {
+            word <<= 8;
+            if (i < value.size()) {
+                word |= static_cast<unsigned char>(value[i]);
+            }
+        }
+        return word;
+    }
+
+    size_t prefixBytes(const KeyColumn& column) {
+        return column.words * sizeof(uint64_t);
+    }
+
+    uint64_t numericKey(const Contact& contact, const SortField field) {
+        if (field == SortField::ID) {
+            return static_cast<uint32_t>(contact.getId()) ^ 0x80000000u;
+        }
+
+        const Date birthDate = contact.getBirthDate();
+        return (static_cast<uint64_t>(static_cast<uint32_t>(birthDate.year) ^ 0x80000000u) << 32) |
+               (static_cast<uint64_t>(static_cast<uint8_t>(birthDate.month)) << 8) |
+               static_cast<uint8_t>(birthDate.day);
+    }
+
+    KeyColumn extractColumn(const std::vector<Contact>& contacts, const SortCriterion& criterion,
+                            const size_t threadCount) {
+        KeyColumn column;
+        column.descending = criterion.direction == SortDirection::DESCENDING;
+        column.getter = stringGetterFor(criterion.field);
+        const uint64_t mask = column.descending ? ~uint64_t{0} : 0;
+        if (column.getter == nullptr) {
+            column.keys.resize(contacts.size());
+            parallelFor(contacts.size(), threadCount, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    column.keys[i] = numericKey(contacts[i], criterion.field) ^ mask;
+                }
+            });
+            return column;
+        }
+
+        size_t maxLength = 0;
+        for (const Contact& contact : contacts) {
+            maxLength = std::max(maxLength, (contact.*column.getter)().size());
+        }
+        column.words = std::min(maxLength / sizeof(uint64_t) + 1, MAX_STRING_KEY_WORDS);
+        column.exact = maxLength < prefixBytes(column);
+        column.keys.resize(contacts.size() * column.words);
+        if (!column.exact) {
+            column.lengths.resize(contacts.size());
+        }
+
+        parallelFor(contacts.size(), threadCount, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                const std::string& value = (contacts[i].*column.getter)();
+                uint64_t* key = &column.keys[i * column.words];
+                for (size_t word = 0; word < column.words; ++word) {
+                    key[word] = packWord(value, word * sizeof(uint64_t));
+                }
+                if (column.exact) {
+                    key[column.words - 1] |= value.size();
+                } else {
+                    column.lengths[i] = static_cast<uint8_t>(std::min(value.size(), prefixBytes(column) + 1));
+                }
+                for (size_t word = 0; word < column.words; ++word) {
+                    key[word] ^= mask;
+                }
+            }
+        });
+        return column;
+    }
+
+    uint64_t keyWord(const KeyColumn& column, const SortRecord& record, const size_t word) {
+        return column.inlined ? record.words[column.inlineOffset + word]
+                              : column.keys[record.index * column.words + word];
+    }
+
+    int compareOnColumn(const std::vector<Contact>& contacts, const KeyColumn& column, const SortRecord& a,
+                        const SortRecord& b) {
+        for (size_t word = 0; word < column.words; ++word) {
+            const uint64_t left = keyWord(column, a, word);
+            const uint64_t right = keyWord(column, b, word);
+            if (left != right) {
+                return left < right ? -1 : 1;
+            }
+        }
+        if (column.exact) {
+            return 0;
+        }
+
+        const size_t leftLength = column.lengths[a.index];
+        const size_t rightLength = column.lengths[b.index];
+        int order;
+        if (leftLength <= prefixBytes(column) || rightLength <= prefixBytes(column)) {
+            order = (leftLength > rightLength) - (leftLength < rightLength);
+        } else {
+            const std::string& left = (contacts[a.index].*column.getter)();
+            const std::string& right = (contacts[b.index].*column.getter)();
+            order = std::string_view(left).substr(prefixBytes(column))
+                        .compare(std::string_view(right).substr(prefixBytes(column)));
+        }
+        return column.descending ? -order : order;
+    }
+
+    size_t assignInlineWords(std::vector<KeyColumn>& columns) {
+        size_t inlineWords = 0;
+        for (KeyColumn& column : columns) {
+            if (inlineWords + column.words > INLINE_KEY_WORDS) {
+                break;
+            }
+            column.inlined = true;
+            column.inlineOffset = inlineWords;
+            inlineWords += column.words;
+            if (!column.exact) {
+                break;
+            }
+        }
+        return inlineWords;
+    }
+
+    template <typename Less>
+    size_t leftRunShare(const std::vector<SortRecord>& records, const size_t first, const size_t middle,
+                        const size_t last, const size_t outputCount, const Less& less) {
+        size_t low = outputCount > last - middle ? outputCount - (last - middle) : 0;
+        size_t high = std::min(outputCount, middle - first);
+        while (low < high) {
+            const size_t taken = low + (high - low) / 2;
+            if (less(records[middle + outputCount - taken - 1], records[first + taken])) {
+                high = taken;
+            } else {
+                low = taken + 1;
+            }
+        }
+        return low;
+    }
+
+    template <typename Less>
+    void parallelMergeSort(std::vector<SortRecord>& records, const size_t threadCount, const Less& less) {
+        std::vector<size_t> runBounds;
+        for (size_t run = 0; run <= threadCount; ++run) {
+            runBounds.push_back(records.size() * run / threadCount);
+        }
+        runTasks(threadCount, [&](const size_t run) {
+            std::sort(records.begin() + static_cast<std::ptrdiff_t>(runBounds[run]),
+                      records.begin() + static_cast<std::ptrdiff_t>(runBounds[run + 1]), less);
+        });
+
+        std::vector<SortRecord> merged(records.size());
+        while (runBounds.size() > 2) {
+            const size_t runCount = runBounds.size() - 1;
+            const size_t pairCount = (runCount + 1) / 2;
+            const size_t piecesPerPair = std::max<size_t>(1, threadCount / pairCount);
+
+            runTasks(pairCount * piecesPerPair, [&](const size_t task) {
+                const size_t pair = task / piecesPerPair;
+                const size_t piece = task % piecesPerPair;
+                const size_t first = runBounds[2 * pair];
+                const size_t middle = runBounds[std::min(2 * pair + 1, runCount)];
+                const size_t last = runBounds[std::min(2 * pair + 2, runCount)];
+
+                const size_t outputFirst = (last - first) * piece / piecesPerPair;
+                const size_t outputLast = (last - first) * (piece + 1) / piecesPerPair;
+                const size_t leftFirst = leftRunShare(records, first, middle, last, outputFirst, less);
+                const size_t leftLast = leftRunShare(records, first, middle, last, outputLast, less);
+
+                std::merge(records.begin() + static_cast<std::ptrdiff_t>(first + leftFirst),
+                           records.begin() + static_cast<std::ptrdiff_t>(first + leftLast),
+                           records.begin() + static_cast<std::ptrdiff_t>(middle + outputFirst - leftFirst),
+                           records.begin() + static_cast<std::ptrdiff_t>(middle + outputLast - leftLast),
+                           merged.begin() + static_cast<std::ptrdiff_t>(first + outputFirst), less);
+            });
+
+            std::vector<size_t> mergedBounds;
+            for (size_t pair = 0; pair < pairCount; ++pair) {
+                mergedBounds.push_back(runBounds[2 * pair]);
+            }
+            mergedBounds.push_back(records.size());
+            runBounds.swap(mergedBounds);
+            records.swap(merged);
+        }
+    }
+}
+
+namespace sorting {
+    size_t hardwareThreadCount() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<uint32_t> sortedPermutation(const std::vector<Contact>& contacts,
+                                            const std::vector<SortCriterion>& criteria, size_t threadCount) {
+        if (threadCount == 0 || contacts.size() < PARALLEL_SORT_MIN_CONTACTS) {
+            threadCount = 1;
+        }
+
+        std::vector<KeyColumn> columns;
+        columns.reserve(criteria.size());
+        bool allNumeric = true;
+        for (const SortCriterion& criterion : criteria) {
+            columns.push_back(extractColumn(contacts, criterion, threadCount));
+            allNumeric = allNumeric && columns.back().getter == nullptr;
+        }
+
+        std::vector<uint32_t> permutation(contacts.size());
+        std::iota(permutation.begin(), permutation.end(), 0u);
+
+        if (allNumeric && threadCount == 1) {
+            for (auto column = columns.rbegin(); column != columns.rend(); ++column) {
+                radixSortByKey(permutation, column->keys);
+            }
+            return permutation;
+        }
+
+        const size_t inlineWords = assignInlineWords(columns);
+        const auto firstIndirect = static_cast<std::ptrdiff_t>(std::count_if(
+            columns.begin(), columns.end(), [](const KeyColumn& column) { return column.inlined && column.exact; }));
+        std::vector<SortRecord> records(contacts.size());
+        parallelFor(records.size(), threadCount, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                records[i].words.fill(0);
+                records[i].index = static_cast<uint32_t>(i);
+                for (const KeyColumn& column : columns) {
+                    if (!column.inlined) {
+                        break;
+                    }
+                    for (size_t word = 0; word < column.words; ++word) {
+                        records[i].words[column.inlineOffset + word] = column.keys[i * column.words + word];
+                    }
+                }
+            }
+        });
+
+        const auto less = [&](const SortRecord& a, const SortRecord& b) {
+            for (size_t word = 0; word < inlineWords; ++word) {
+                if (a.words[word] != b.words[word]) {
+                    return a.words[word] < b.words[word];
+                }
+            }
+            for (auto column = columns.begin() + firstIndirect; column != columns.end(); ++column) {
+                const int order = compareOnColumn(contacts, *column, a, b);
+                if (order != 0) {
+                    return order < 0;
+                }
+            }
+            return a.index < b.index;
+        };
+        if (threadCount == 1) {
+            std::sort(records.begin(), records.end(), less);
+        } else {
+            parallelMergeSort(records, threadCount, less);
+        }
+
+        for (size_t i = 0; i < records.size(); ++i) {
+            permutation[i] = records[i].index;
+        }
+        return permutation;
+    }
+
+    void radixSortByKey(std::vector<uint32_t>& permutation, const std::vector<uint64_t>& keys) {
+        std::vector<uint32_t> buffer(permutation.size());
+
+        for (unsigned shift = 0; shift < 64; shift += 8) {
+            std::array<size_t, 256> counts{};
+            for (const uint32_t index : permutation) {
+                ++counts[(keys[index] >> shift) & 0xFF];
+            }
+            if (std::count(counts.begin(), counts.end(), 0) == 255) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t& count : counts) {
+                const size_t bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+
+            for (const uint32_t index : permutation) {
+                buffer[counts[(keys[index] >> shift) & 0xFF]++] = index;
+            }
+            permutation.swap(buffer);
+        }
+    }
+
+    void applyPermutation(std::vector<Contact>& contacts, const std::vector<uint32_t>& permutation) {
+        std::vector<bool> placed(contacts.size(), false);
+
+        for (size_t start = 0; start < contacts.size(); ++start) {
+            if (placed[start]) {
+                continue;
+            }
+            placed[start] = true;
+            if (permutation[start] == start) {
+                continue;
+            }
+
+            Contact displaced = std::move(contacts[start]);
+            size_t slot = start;
+            while (permutation[slot] != start) {
+                const size_t source = permutation[slot];
+                contacts[slot] = std::move(contacts[source]);
+                placed[source] = true;
+                slot = source;
+            }
+            contacts[slot] = std::move(displaced);
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "Contact.h"
+#include "SortCriterion.h"
+#include <cstdint>
+#include <vector>
+
+namespace sorting {
+    size_t hardwareThreadCount();
+
+    std::vector<uint32_t> sortedPermutation(const std::vector<Contact>& contacts,
+                                            const std::vector<SortCriterion>& criteria,
+                                            size_t threadCount = hardwareThreadCount());
+
+    void radixSortByKey(std::vector<uint32_t>& permutation, const std::vector<uint64_t>& keys);
+
+    void applyPermutation(std::vector<Contact>& contacts, const std::vector<uint32_t>& permutation);
+}
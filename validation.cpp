@@ -4,23 +4,55 @@
 #include <ctime>
 #include <regex>
 
+namespace {
+    bool isAsciiLetter(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    bool isAsciiDigit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    bool isAsciiAlnum(const char c) {
+        return isAsciiLetter(c) || isAsciiDigit(c);
+    }
+}
+
 namespace validation {
     std::string trim(const std::string& str) {
-        const std::string whitespace = " \t\n\r\f\v";
+        return std::string(trimView(str));
+    }
+
+    std::string_view trimView(const std::string_view str) {
+        const std::string_view whitespace = " \t\n\r\f\v";
         const size_t first = str.find_first_not_of(whitespace);
-        if (first == std::string::npos) {
-            return "";
+        if (first == std::string_view::npos) {
+            return {};
         }
         const size_t last = str.find_last_not_of(whitespace);
         return str.substr(first, last - first + 1);
     }
 
-    bool isValidName(const std::string& name) {
-        const std::regex nameRegex("^[a-zA-Z]([a-zA-Z0-9- ]*[a-zA-Z0-9])?$");
+    bool isValidName(const std::string_view name) {
+        if (name.empty() || !isAsciiLetter(name.front())) {
+            return false;
+        }
+        if (name.size() == 1) {
+            return true;
+        }
+        if (!isAsciiAlnum(name.back())) {
+            return false;
+        }
+        return std::all_of(name.begin() + 1, name.end() - 1,
+                           [](const char c) { return isAsciiAlnum(c) || c == '-' || c == ' '; });
+    }
+
+    bool isValidNameRegex(const std::string& name) {
+        static const std::regex nameRegex("^[a-zA-Z]([a-zA-Z0-9- ]*[a-zA-Z0-9])?$");
         return std::regex_match(name, nameRegex);
     }
 
-    bool isValidAddress(const std::string& address) {
+    bool isValidAddress(const std::string_view address) {
         return true;
     }
 
@@ -47,10 +79,15 @@ namespace validation {
         }
 
         const time_t t = time(nullptr);
-        const tm* now = localtime(&t);
-        const int currentYear = now->tm_year + 1900;
-        const int currentMonth = now->tm_mon + 1;
-        const int currentDay = now->tm_mday;
+        tm now{};
+#ifdef _WIN32
+        localtime_s(&now, &t);
+#else
+        localtime_r(&t, &now);
+#endif
+        const int currentYear = now.tm_year + 1900;
+        const int currentMonth = now.tm_mon + 1;
+        const int currentDay = now.tm_mday;
 
         const int inputDateAsNumber = year * 10000 + month * 100 + day;
 
@@ -63,29 +100,101 @@ namespace validation {
         return true;
     }
 
-    bool isValidEmail(const std::string& email) {
-        const std::regex emailRegex("^[a-zA-Z0-9_.-]+@[a-zA-Z0-9-]+\\.[a-zA-Z]{2,}$");
+    bool isValidEmail(const std::string_view email) {
+        const size_t atPos = email.find('@');
+        if (atPos == std::string_view::npos || atPos == 0) {
+            return false;
+        }
+
+        const std::string_view localPart = email.substr(0, atPos);
+        if (!std::all_of(localPart.begin(), localPart.end(),
+                         [](const char c) { return isAsciiAlnum(c) || c == '_' || c == '.' || c == '-'; })) {
+            return false;
+        }
+
+        const std::string_view domain = email.substr(atPos + 1);
+        const size_t dotPos = domain.find('.');
+        if (dotPos == std::string_view::npos || dotPos == 0) {
+            return false;
+        }
+
+        const std::string_view label = domain.substr(0, dotPos);
+        const std::string_view topLevel = domain.substr(dotPos + 1);
+
+        return std::all_of(label.begin(), label.end(), [](const char c) { return isAsciiAlnum(c) || c == '-'; }) &&
+               topLevel.size() >= 2 && std::all_of(topLevel.begin(), topLevel.end(), isAsciiLetter);
+    }
+
+    bool isValidEmailRegex(const std::string& email) {
+        static const std::regex emailRegex("^[a-zA-Z0-9_.-]+@[a-zA-Z0-9-]+\\.[a-zA-Z]{2,}$");
         return std::regex_match(email, emailRegex);
     }
 
-    bool isValidPhoneType(const std::string& type) {
+    bool isValidPhoneType(const std::string_view type) {
         return !type.empty();
     }
 
-    bool isValidPhoneNumber(const std::string& phone) {
-        const std::regex phoneRegex(R"(^(\+7|8) ?\(?\d{3}\)? ?\d{3}(-?\d{2}){2}$)");
+    bool isValidPhoneNumber(const std::string_view phone) {
+        size_t pos = 0;
+
+        const auto skipOptional = [&](const char c) {
+            if (pos < phone.size() && phone[pos] == c) {
+                ++pos;
+            }
+        };
+        const auto consumeDigits = [&](const size_t count) {
+            for (size_t i = 0; i < count; ++i, ++pos) {
+                if (pos >= phone.size() || !isAsciiDigit(phone[pos])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        if (phone.substr(0, 2) == "+7") {
+            pos = 2;
+        } else if (!phone.empty() && phone.front() == '8') {
+            pos = 1;
+        } else {
+            return false;
+        }
+
+        skipOptional(' ');
+        skipOptional('(');
+        if (!consumeDigits(3)) {
+            return false;
+        }
+        skipOptional(')');
+        skipOptional(' ');
+        if (!consumeDigits(3)) {
+            return false;
+        }
+        for (int group = 0; group < 2; ++group) {
+            skipOptional('-');
+            if (!consumeDigits(2)) {
+                return false;
+            }
+        }
+        return pos == phone.size();
+    }
+
+    bool isValidPhoneNumberRegex(const std::string& phone) {
+        static const std::regex phoneRegex(R"(^(\+7|8) ?\(?\d{3}\)? ?\d{3}(-?\d{2}){2}$)");
         return std::regex_match(phone, phoneRegex);
     }
 
     std::string normalizeEmail(const std::string& email) {
         std::string normalizedEmail = email;
+        normalizeEmailInPlace(normalizedEmail);
+        return normalizedEmail;
+    }
 
-        normalizedEmail.erase( std::remove_if(normalizedEmail.begin(), normalizedEmail.end(),
-                                         [](unsigned char c){ return std::isspace(c); }), normalizedEmail.end());
+    void normalizeEmailInPlace(std::string& email) {
+        email.erase(std::remove_if(email.begin(), email.end(),
+                                   [](unsigned char c){ return std::isspace(c); }), email.end());
 
-        std::transform(normalizedEmail.begin(), normalizedEmail.end(), normalizedEmail.begin(),
+        std::transform(email.begin(), email.end(), email.begin(),
                        [](unsigned char c){ return std::tolower(c); });
-        return normalizedEmail;
     }
 
     std::string normalizePhoneNumber(const std::string& phone) {
@@ -105,6 +214,17 @@ namespace validation {
         return digits;
     }
 
+    std::string phoneSearchDigits(const std::string& query) {
+        std::string digits;
+        std::copy_if(query.begin(), query.end(), std::back_inserter(digits),
+                     [](char c){ return std::isdigit(c); });
+
+        if (!digits.empty() && digits.front() == '8') {
+            digits[0] = '7';
+        }
+        return digits;
+    }
+
     bool isForenameInEmail(const std::string& email, const std::string& forename) {
         std::string normalizedEmail = normalizeEmail(email);
         std::string lowerName = forename;
@@ -1,18 +1,26 @@
 #pragma once
 #include <string>
+#include <string_view>
 
 namespace validation {
     std::string trim(const std::string& str);
+    std::string_view trimView(std::string_view str);
 
-    bool isValidName(const std::string& name);
-    bool isValidAddress(const std::string& address);
+    bool isValidName(std::string_view name);
+    bool isValidAddress(std::string_view address);
     bool isValidDate(int day, int month, int year);
-    bool isValidEmail(const std::string& email);
-    bool isValidPhoneType(const std::string& type);
-    bool isValidPhoneNumber(const std::string& phone);
+    bool isValidEmail(std::string_view email);
+    bool isValidPhoneType(std::string_view type);
+    bool isValidPhoneNumber(std::string_view phone);
+
+    bool isValidNameRegex(const std::string& name);
+    bool isValidEmailRegex(const std::string& email);
+    bool isValidPhoneNumberRegex(const std::string& phone);
 
     std::string normalizeEmail(const std::string& email);
+    void normalizeEmailInPlace(std::string& email);
     std::string normalizePhoneNumber(const std::string& phone);
+    std::string phoneSearchDigits(const std::string& query);
 
     bool isForenameInEmail(const std::string& email, const std::string& forename);
 }